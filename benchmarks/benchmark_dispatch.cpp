@@ -0,0 +1,153 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/wrapper.hpp"
+
+/**
+ * Measure the latency and the number of heap allocations per launch of a
+ * small kernel dispatched with `dynk::parallel_for` and with `dynk::wrap`,
+ * with a string literal label and with an interned label.
+ *
+ * Allocations are counted by replacing the global allocation functions. The
+ * program fails if the interned label paths allocate in steady state. Note
+ * that Kokkos profiling tools, if loaded, may allocate on their own.
+ */
+
+std::atomic<std::size_t> allocationsCount{0};
+
+void *operator new(std::size_t const size) {
+  allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *const pointer = std::malloc(size > 0 ? size : 1)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *const pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+using DualView = Kokkos::DualView<double *>;
+using View = decltype(dynk::getView(std::declval<DualView &>(), false));
+
+struct ScaleFunctor {
+  View mA;
+
+  explicit ScaleFunctor(View const a) : mA(a) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const { mA(i) *= 1.000001; }
+};
+
+struct Result {
+  double timePerLaunch;
+  double allocationsPerLaunch;
+};
+
+template <typename Launch>
+Result benchmark(Launch const &launch, int const repetitions) {
+  // warm up, to exclude one-time allocations (e.g. interning)
+  launch();
+
+  std::size_t const allocationsStart = allocationsCount.load();
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    launch();
+  }
+  double const time = timer.seconds();
+  std::size_t const allocations = allocationsCount.load() - allocationsStart;
+
+  return {time / repetitions,
+          static_cast<double>(allocations) / repetitions};
+}
+
+void report(std::string const &name, Result const &result) {
+  std::cout << "  " << name << ": " << result.timePerLaunch * 1e6
+            << " us/launch, " << result.allocationsPerLaunch
+            << " allocations/launch\n";
+}
+
+int main(int argc, char *argv[]) {
+  int size = 1000;
+  int repetitions = 100000;
+  if (argc > 1) {
+    size = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    repetitions = std::stoi(argv[2]);
+  }
+
+  Kokkos::ScopeGuard kokkos(argc, argv);
+
+  DualView aDV("a", size);
+  auto aV = dynk::getSyncedView(aDV, false);
+  ScaleFunctor const scale(aV);
+  auto const policy = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(
+      0, size);
+
+  std::cout << "Host kernel of " << size << " elements, " << repetitions
+            << " repetitions\n";
+
+  // labels longer than the small string buffer of the standard library
+  Result const layerLiteral = benchmark(
+      [&]() {
+        dynk::parallel_for(false, "benchmark dispatch layer literal", size,
+                           scale);
+      },
+      repetitions);
+  Result const layerLabel = benchmark(
+      [&]() {
+        dynk::parallel_for(
+            false, DYNK_LABEL("benchmark dispatch layer interned"), size,
+            scale);
+      },
+      repetitions);
+  Result const wrapLiteral = benchmark(
+      [&]() {
+        dynk::wrap(
+            false, [&]() {},
+            [&]() {
+              Kokkos::parallel_for("benchmark dispatch wrap literal", policy,
+                                   scale);
+            });
+      },
+      repetitions);
+  Result const wrapLabel = benchmark(
+      [&]() {
+        dynk::wrap(
+            false, [&]() {},
+            [&]() {
+              Kokkos::parallel_for(
+                  DYNK_LABEL("benchmark dispatch wrap interned"), policy,
+                  scale);
+            });
+      },
+      repetitions);
+
+  std::cout << "Layer\n";
+  report("string literal", layerLiteral);
+  report("interned label", layerLabel);
+  std::cout << "Wrapper\n";
+  report("string literal", wrapLiteral);
+  report("interned label", wrapLabel);
+
+  dynk::setModified(aDV, false);
+
+  if (layerLabel.allocationsPerLaunch > 0 ||
+      wrapLabel.allocationsPerLaunch > 0) {
+    std::cout << "Heap allocations found with interned labels\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/first_touch.hpp"
+#include "dynk/layer.hpp"
+
+/**
+ * Compare the bandwidth of a triad kernel executed on the host with DualViews
+ * created by the DualView constructor and by `dynk::createDualView`.
+ *
+ * Differences only appear on a multi-socket node with bound threads, e.g.
+ * with `OMP_PROC_BIND=spread OMP_PLACES=threads` for OpenMP.
+ */
+
+using DualView = Kokkos::DualView<double *>;
+
+template <typename View> struct TriadFunctor {
+  View mA;
+  View mB;
+  View mC;
+  double mScalar;
+
+  TriadFunctor(View const a, View const b, View const c, double const scalar)
+      : mA(a), mB(b), mC(c), mScalar(scalar) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const {
+    mA(i) = mB(i) + mScalar * mC(i);
+  }
+};
+
+double benchmarkTriad(DualView &aDV, DualView &bDV, DualView &cDV,
+                      int const repetitions) {
+  bool const isExecutedOnDevice = false;
+  auto aV = dynk::getSyncedView(aDV, isExecutedOnDevice);
+  auto bV = dynk::getSyncedView(bDV, isExecutedOnDevice);
+  auto cV = dynk::getSyncedView(cDV, isExecutedOnDevice);
+  int const size = aDV.extent(0);
+
+  // warm up
+  dynk::parallel_for(isExecutedOnDevice, "triad", size,
+                     TriadFunctor(aV, bV, cV, 3.));
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    dynk::parallel_for(isExecutedOnDevice, "triad", size,
+                       TriadFunctor(aV, bV, cV, 3.));
+  }
+  double const time = timer.seconds();
+
+  dynk::setModified(aDV, isExecutedOnDevice);
+  return time;
+}
+
+int main(int argc, char *argv[]) {
+  int size = 100000000;
+  int repetitions = 20;
+  if (argc > 1) {
+    size = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    repetitions = std::stoi(argv[2]);
+  }
+
+  Kokkos::ScopeGuard kokkos(argc, argv);
+
+  double timeConstructor = 0;
+  {
+    DualView aDV("a", size);
+    DualView bDV("b", size);
+    DualView cDV("c", size);
+    timeConstructor = benchmarkTriad(aDV, bDV, cDV, repetitions);
+  }
+
+  double timeFirstTouch = 0;
+  {
+    auto aDV = dynk::createDualView<DualView>("a", size);
+    auto bDV = dynk::createDualView<DualView>("b", size);
+    auto cDV = dynk::createDualView<DualView>("c", size);
+    timeFirstTouch = benchmarkTriad(aDV, bDV, cDV, repetitions);
+  }
+
+  double const bytes = 3. * sizeof(double) * size * repetitions;
+  std::cout << "Host triad of " << size << " elements, " << repetitions
+            << " repetitions, with "
+            << Kokkos::DefaultHostExecutionSpace().concurrency()
+            << " threads\n";
+  std::cout << "DualView constructor: " << timeConstructor << " s, "
+            << bytes / timeConstructor * 1e-9 << " GB/s\n";
+  std::cout << "dynk::createDualView: " << timeFirstTouch << " s, "
+            << bytes / timeFirstTouch * 1e-9 << " GB/s\n";
+}
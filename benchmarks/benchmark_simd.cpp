@@ -0,0 +1,124 @@
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/layer.hpp"
+#include "dynk/simd.hpp"
+
+/**
+ * Compare the bandwidth of stream-like kernels executed on the host with
+ * `dynk::parallel_for` and with `dynk::simd_for`.
+ */
+
+using DualView = Kokkos::DualView<double *>;
+using View = decltype(dynk::getView(std::declval<DualView &>(), false));
+
+struct ScaleFunctor {
+  View mA;
+  View mB;
+
+  ScaleFunctor(View const a, View const b) : mA(a), mB(b) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const { mA(i) = 3. * mB(i); }
+
+  template <typename Pack>
+  KOKKOS_FUNCTION void operator()(dynk::SimdIndex<Pack> const index) const {
+    dynk::simdStore(3. * dynk::simdLoad(mB, index), mA, index);
+  }
+};
+
+struct TriadFunctor {
+  View mA;
+  View mB;
+  View mC;
+
+  TriadFunctor(View const a, View const b, View const c)
+      : mA(a), mB(b), mC(c) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const {
+    mA(i) = mB(i) + 3. * mC(i);
+  }
+
+  template <typename Pack>
+  KOKKOS_FUNCTION void operator()(dynk::SimdIndex<Pack> const index) const {
+    auto const b = dynk::simdLoad(mB, index);
+    auto const c = dynk::simdLoad(mC, index);
+    dynk::simdStore(b + 3. * c, mA, index);
+  }
+};
+
+template <typename Functor>
+double benchmarkParallelFor(Functor const &functor, int const size,
+                            int const repetitions) {
+  dynk::parallel_for(false, "parallel for", size, functor);
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    dynk::parallel_for(false, "parallel for", size, functor);
+  }
+  return timer.seconds();
+}
+
+template <typename Functor>
+double benchmarkSimdFor(Functor const &functor, int const size,
+                        int const repetitions) {
+  dynk::simd_for<double>(false, "simd for", size, functor);
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    dynk::simd_for<double>(false, "simd for", size, functor);
+  }
+  return timer.seconds();
+}
+
+void report(std::string const &name, double const bytes,
+            double const timeParallelFor, double const timeSimdFor) {
+  std::cout << name << "\n";
+  std::cout << "  dynk::parallel_for: " << timeParallelFor << " s, "
+            << bytes / timeParallelFor * 1e-9 << " GB/s\n";
+  std::cout << "  dynk::simd_for:     " << timeSimdFor << " s, "
+            << bytes / timeSimdFor * 1e-9 << " GB/s\n";
+}
+
+int main(int argc, char *argv[]) {
+  int size = 10000000;
+  int repetitions = 100;
+  if (argc > 1) {
+    size = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    repetitions = std::stoi(argv[2]);
+  }
+
+  Kokkos::ScopeGuard kokkos(argc, argv);
+
+  DualView aDV("a", size);
+  DualView bDV("b", size);
+  DualView cDV("c", size);
+  Kokkos::deep_copy(bDV.h_view, 1.);
+  Kokkos::deep_copy(cDV.h_view, 2.);
+  bDV.modify_host();
+  cDV.modify_host();
+
+  auto aV = dynk::getView(aDV, false);
+  auto bV = dynk::getSyncedView(bDV, false);
+  auto cV = dynk::getSyncedView(cDV, false);
+
+  std::cout << "Host kernels of " << size << " elements, " << repetitions
+            << " repetitions\n";
+
+  ScaleFunctor const scale(aV, bV);
+  report("Scale", 2. * sizeof(double) * size * repetitions,
+         benchmarkParallelFor(scale, size, repetitions),
+         benchmarkSimdFor(scale, size, repetitions));
+
+  TriadFunctor const triad(aV, bV, cV);
+  report("Triad", 3. * sizeof(double) * size * repetitions,
+         benchmarkParallelFor(triad, size, repetitions),
+         benchmarkSimdFor(triad, size, repetitions));
+
+  dynk::setModified(aDV, false);
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/layer.hpp"
+
+/**
+ * Compare the performance of a triad kernel in the layer approach with
+ * `Kokkos::AnonymousSpace` views and with views typed for the chosen memory
+ * space using a kernel factory.
+ */
+
+template <typename ViewA, typename ViewBC> struct TriadFunctor {
+  ViewA mA;
+  ViewBC mB;
+  ViewBC mC;
+  double mScalar;
+
+  TriadFunctor(ViewA const a, ViewBC const b, ViewBC const c,
+               double const scalar)
+      : mA(a), mB(b), mC(c), mScalar(scalar) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const {
+    mA(i) = mB(i) + mScalar * mC(i);
+  }
+};
+
+using DualView = Kokkos::DualView<double *>;
+
+double benchmarkAnonymousViews(bool const isExecutedOnDevice, DualView &aDV,
+                               DualView &bDV, DualView &cDV,
+                               int const repetitions) {
+  auto aV = dynk::getSyncedView(aDV, isExecutedOnDevice);
+  auto bV = dynk::getSyncedView(bDV, isExecutedOnDevice);
+  auto cV = dynk::getSyncedView(cDV, isExecutedOnDevice);
+  int const size = aDV.extent(0);
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    dynk::parallel_for(isExecutedOnDevice, "triad anonymous views", size,
+                       TriadFunctor(aV, bV, cV, 3.));
+  }
+  double const time = timer.seconds();
+
+  dynk::setModified(aDV, isExecutedOnDevice);
+  return time;
+}
+
+double benchmarkTypedViews(bool const isExecutedOnDevice, DualView &aDV,
+                           DualView &bDV, DualView &cDV,
+                           int const repetitions) {
+  // synchronized once, as for AnonymousSpace views
+  dynk::getSyncedView(aDV, isExecutedOnDevice);
+  dynk::getSyncedView(bDV, isExecutedOnDevice);
+  dynk::getSyncedView(cDV, isExecutedOnDevice);
+  int const size = aDV.extent(0);
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    dynk::parallel_for(
+        isExecutedOnDevice, "triad typed views", size,
+        dynk::KernelFactory([&](auto memorySpace) {
+          using MemorySpace = decltype(memorySpace);
+          return TriadFunctor(dynk::getView<MemorySpace>(aDV),
+                              dynk::getView<MemorySpace>(bDV),
+                              dynk::getView<MemorySpace>(cDV), 3.);
+        }));
+  }
+  double const time = timer.seconds();
+
+  dynk::setModified(aDV, isExecutedOnDevice);
+  return time;
+}
+
+int main(int argc, char *argv[]) {
+  int size = 10000000;
+  int repetitions = 100;
+  bool isExecutedOnDevice = false;
+  if (argc > 1) {
+    size = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    repetitions = std::stoi(argv[2]);
+  }
+  if (argc > 3) {
+    isExecutedOnDevice = std::stoi(argv[3]) != 0;
+  }
+
+  Kokkos::ScopeGuard kokkos(argc, argv);
+
+  DualView aDV("a", size);
+  DualView bDV("b", size);
+  DualView cDV("c", size);
+  Kokkos::deep_copy(bDV.h_view, 1.);
+  Kokkos::deep_copy(cDV.h_view, 2.);
+  bDV.modify_host();
+  cDV.modify_host();
+
+  // warm up
+  benchmarkAnonymousViews(isExecutedOnDevice, aDV, bDV, cDV, 1);
+  benchmarkTypedViews(isExecutedOnDevice, aDV, bDV, cDV, 1);
+
+  double const timeAnonymous =
+      benchmarkAnonymousViews(isExecutedOnDevice, aDV, bDV, cDV, repetitions);
+  double const timeTyped =
+      benchmarkTypedViews(isExecutedOnDevice, aDV, bDV, cDV, repetitions);
+
+  double const bytes = 3. * sizeof(double) * size * repetitions;
+  std::cout << "Triad of " << size << " elements, " << repetitions
+            << " repetitions, on "
+            << (isExecutedOnDevice ? "device" : "host") << "\n";
+  std::cout << "AnonymousSpace views: " << timeAnonymous << " s, "
+            << bytes / timeAnonymous * 1e-9 << " GB/s\n";
+  std::cout << "Typed views:          " << timeTyped << " s, "
+            << bytes / timeTyped * 1e-9 << " GB/s\n";
+}
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/layer.hpp"
+
+/**
+ * Compare the time of kernels alternating between the device and the host
+ * with DualViews mirroring data and with DualViews sharing a single
+ * allocation in `Kokkos::SharedSpace`.
+ *
+ * The kind of DualView is chosen at run time, so that both can be compared
+ * with the same build.
+ */
+
+template <typename DualView>
+double benchmarkAlternate(int const size, int const repetitions,
+                          int const hostEvery) {
+  DualView dataDV("data", size);
+
+  Kokkos::Timer timer;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    // most iterations on device, some on host
+    bool const isExecutedOnDevice = repetition % hostEvery != 0;
+    auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+    dynk::parallel_for(
+        isExecutedOnDevice, "alternate", size,
+        KOKKOS_LAMBDA(int const i) { dataV(i) += 1.; });
+    dynk::setModified(dataDV, isExecutedOnDevice);
+  }
+  dynk::getSyncedView(dataDV, false);
+  return timer.seconds();
+}
+
+int main(int argc, char *argv[]) {
+  std::string mode = "both";
+  int size = 10000000;
+  int repetitions = 100;
+  int hostEvery = 10;
+  if (argc > 1) {
+    mode = argv[1];
+  }
+  if (argc > 2) {
+    size = std::stoi(argv[2]);
+  }
+  if (argc > 3) {
+    repetitions = std::stoi(argv[3]);
+  }
+  if (argc > 4) {
+    hostEvery = std::stoi(argv[4]);
+  }
+
+  Kokkos::ScopeGuard kokkos(argc, argv);
+
+  std::cout << "Kernels of " << size << " elements, " << repetitions
+            << " repetitions, on host every " << hostEvery << "\n";
+
+  if (mode == "both" || mode == "mirror") {
+    std::cout << "  Mirrored DualView: "
+              << benchmarkAlternate<Kokkos::DualView<double *>>(
+                     size, repetitions, hostEvery)
+              << " s\n";
+  }
+
+#ifdef KOKKOS_HAS_SHARED_SPACE
+  if (mode == "both" || mode == "shared") {
+    std::cout << "  Shared DualView: "
+              << benchmarkAlternate<dynk::SharedDualView<double *>>(
+                     size, repetitions, hostEvery)
+              << " s\n";
+
+    dynk::enableSharedPrefetch();
+    std::cout << "  Shared DualView with prefetch: "
+              << benchmarkAlternate<dynk::SharedDualView<double *>>(
+                     size, repetitions, hostEvery)
+              << " s\n";
+  }
+#else
+  if (mode == "shared") {
+    std::cerr << "Kokkos::SharedSpace is not available\n";
+  }
+#endif // ifdef KOKKOS_HAS_SHARED_SPACE
+}
@@ -4,6 +4,12 @@ option(DYNK_ENABLE_TESTS "Build tests for the library")
 # examples
 option(DYNK_ENABLE_EXAMPLES "Build examples of the library")
 
+# benchmarks
+option(DYNK_ENABLE_BENCHMARKS "Build benchmarks of the library")
+
+# tools
+option(DYNK_ENABLE_TOOLS "Build tools of the library")
+
 # wrapper approach
 option(DYNK_ENABLE_CXX20_FEATURES "Allow to use C++20 features" ON)
 
@@ -21,6 +27,18 @@ if(DYNK_ENABLE_EXTENDED_LAMBDA_IN_GENERIC_LAMBDA)
     endif()
 endif()
 
+# synchronization diagnostics
+option(DYNK_ENABLE_SYNC_DIAGNOSTICS "Record the modify/sync history of DualViews and report wasted transfers at finalization")
+
+# zero-copy mode
+option(DYNK_ENABLE_ZERO_COPY "Make dynk::DualView share a single allocation in Kokkos::SharedSpace for both sides instead of mirroring data")
+
+# placement log
+option(DYNK_ENABLE_PLACEMENT_LOG "Record the placement decisions and durations of dynamic parallel constructs to a binary log")
+
+# thread-safe mode
+option(DYNK_ENABLE_THREAD_SAFE "Allow dynamic constructs to be called concurrently from several host threads, each using its own execution space instances")
+
 # allow gtest to discover tests
 option(DYNK_ENABLE_GTEST_DISCOVER_TESTS "Enable Gtest to discover tests by attempting to run them" ON)
 
@@ -0,0 +1,455 @@
+#ifndef __DYNK_ALGORITHMS_HPP__
+#define __DYNK_ALGORITHMS_HPP__
+
+/**
+ * Dynamic algorithms.
+ *
+ * This file proposes alternative versions of common Kokkos algorithms
+ * (`Kokkos::sort` and the Kokkos standard algorithms) that operate on
+ * DualViews and are executed dynamically on device or on host depending on a
+ * Boolean parameter. Input DualViews are synchronized on the chosen side,
+ * output DualViews are marked as modified on the chosen side, using the
+ * helpers of `dual_view.hpp`. Output DualViews that are entirely overwritten
+ * are not synchronized.
+ *
+ * Only rank 1 DualViews are supported, as for the Kokkos standard algorithms.
+ */
+
+#include <cstddef>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <Kokkos_Sort.hpp>
+#include <Kokkos_StdAlgorithms.hpp>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/label.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Call an algorithm on device or on host.
+ *
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution.
+ * @tparam HostMemorySpace Kokkos memory space for host memory.
+ * @tparam Algorithm Type of the algorithm.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param algorithm Callable taking an instance of the execution space and of
+ * the memory space of the chosen side.
+ * @return Return value of the algorithm, if any.
+ */
+template <typename DeviceExecutionSpace, typename DeviceMemorySpace,
+          typename HostExecutionSpace, typename HostMemorySpace,
+          typename Algorithm>
+auto dispatchAlgorithm(bool const isExecutedOnDevice,
+                       Algorithm const &algorithm) {
+  using Result = std::invoke_result_t<Algorithm const &, HostExecutionSpace,
+                                      HostMemorySpace>;
+
+  fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic algorithm"));
+
+  if constexpr (std::is_void_v<Result>) {
+    if (isExecutedOnDevice) {
+      algorithm(getSpace<DeviceExecutionSpace>(), DeviceMemorySpace{});
+    } else {
+      algorithm(getSpace<HostExecutionSpace>(), HostMemorySpace{});
+    }
+
+    recordDispatch(isExecutedOnDevice);
+    fence<DeviceExecutionSpace, HostExecutionSpace>(
+        DYNK_LABEL("end of dynamic algorithm"));
+  } else {
+    Result const result =
+        isExecutedOnDevice
+            ? algorithm(getSpace<DeviceExecutionSpace>(), DeviceMemorySpace{})
+            : algorithm(getSpace<HostExecutionSpace>(), HostMemorySpace{});
+
+    recordDispatch(isExecutedOnDevice);
+    fence<DeviceExecutionSpace, HostExecutionSpace>(
+        DYNK_LABEL("end of dynamic algorithm"));
+    return result;
+  }
+}
+
+} // namespace impl
+
+/**
+ * Sort a DualView dynamically.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to sort.
+ */
+template <
+    typename DualView,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void sort(bool const isExecutedOnDevice, DualView &dualView) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::sort(space, getSyncedView<MemorySpace>(dualView));
+        setModified<MemorySpace>(dualView);
+      });
+}
+
+/**
+ * Sort a DualView dynamically with a comparator.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam Comparator Type of the comparator.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to sort.
+ * @param comparator Comparator, callable on device and on host.
+ */
+template <
+    typename DualView, typename Comparator,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void sort(bool const isExecutedOnDevice, DualView &dualView,
+          Comparator const &comparator) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::sort(space, getSyncedView<MemorySpace>(dualView), comparator);
+        setModified<MemorySpace>(dualView);
+      });
+}
+
+/**
+ * Compute the exclusive prefix sum of a DualView into another one
+ * dynamically.
+ *
+ * @tparam DualViewSource Type of the source DualView.
+ * @tparam DualViewDestination Type of the destination DualView.
+ * @tparam Value Type of the initial value.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param source Source DualView.
+ * @param destination Destination DualView, may be the source one.
+ * @param initialValue Initial value of the sum.
+ */
+template <
+    typename DualViewSource, typename DualViewDestination, typename Value,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void exclusive_scan(bool const isExecutedOnDevice, DualViewSource &source,
+                    DualViewDestination &destination,
+                    Value const initialValue) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::Experimental::exclusive_scan(
+            space, getSyncedView<MemorySpace>(source),
+            getView<MemorySpace>(destination), initialValue);
+        setModified<MemorySpace>(destination);
+      });
+}
+
+/**
+ * Compute the inclusive prefix sum of a DualView into another one
+ * dynamically.
+ *
+ * @tparam DualViewSource Type of the source DualView.
+ * @tparam DualViewDestination Type of the destination DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param source Source DualView.
+ * @param destination Destination DualView, may be the source one.
+ */
+template <
+    typename DualViewSource, typename DualViewDestination,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void inclusive_scan(bool const isExecutedOnDevice, DualViewSource &source,
+                    DualViewDestination &destination) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::Experimental::inclusive_scan(
+            space, getSyncedView<MemorySpace>(source),
+            getView<MemorySpace>(destination));
+        setModified<MemorySpace>(destination);
+      });
+}
+
+/**
+ * Apply an operation to each element of a DualView and store the result in
+ * another one dynamically.
+ *
+ * @tparam DualViewSource Type of the source DualView.
+ * @tparam DualViewDestination Type of the destination DualView.
+ * @tparam Operation Type of the unary operation.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param source Source DualView.
+ * @param destination Destination DualView, may be the source one.
+ * @param operation Unary operation, callable on device and on host.
+ */
+template <
+    typename DualViewSource, typename DualViewDestination, typename Operation,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void transform(bool const isExecutedOnDevice, DualViewSource &source,
+               DualViewDestination &destination, Operation const &operation) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::Experimental::transform(
+            space, getSyncedView<MemorySpace>(source),
+            getView<MemorySpace>(destination), operation);
+        setModified<MemorySpace>(destination);
+      });
+}
+
+/**
+ * Compute the sum of the elements of a DualView dynamically.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to reduce.
+ * @return Sum of the elements.
+ */
+template <
+    typename DualView,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+typename DualView::t_host::non_const_value_type
+reduce(bool const isExecutedOnDevice, DualView &dualView) {
+  return impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                                 HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        return Kokkos::Experimental::reduce(
+            space, getSyncedView<MemorySpace>(dualView));
+      });
+}
+
+/**
+ * Find the index of the smallest element of a DualView dynamically.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to search.
+ * @return Index of the first smallest element, as iterators of the chosen
+ * side cannot be used on the other side.
+ */
+template <
+    typename DualView,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+std::size_t min_element(bool const isExecutedOnDevice, DualView &dualView) {
+  return impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                                 HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        auto const view = getSyncedView<MemorySpace>(dualView);
+        return static_cast<std::size_t>(Kokkos::Experimental::distance(
+            Kokkos::Experimental::begin(view),
+            Kokkos::Experimental::min_element(space, view)));
+      });
+}
+
+/**
+ * Find the index of the largest element of a DualView dynamically.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to search.
+ * @return Index of the first largest element, as iterators of the chosen
+ * side cannot be used on the other side.
+ */
+template <
+    typename DualView,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+std::size_t max_element(bool const isExecutedOnDevice, DualView &dualView) {
+  return impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                                 HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        auto const view = getSyncedView<MemorySpace>(dualView);
+        return static_cast<std::size_t>(Kokkos::Experimental::distance(
+            Kokkos::Experimental::begin(view),
+            Kokkos::Experimental::max_element(space, view)));
+      });
+}
+
+/**
+ * Fill a DualView with a value dynamically.
+ *
+ * The DualView is not synchronized, as it is entirely overwritten.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam Value Type of the value.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param dualView DualView to fill.
+ * @param value Value to fill with.
+ */
+template <
+    typename DualView, typename Value,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void fill(bool const isExecutedOnDevice, DualView &dualView,
+          Value const &value) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::Experimental::fill(space, getView<MemorySpace>(dualView),
+                                   value);
+        setModified<MemorySpace>(dualView);
+      });
+}
+
+/**
+ * Copy a DualView into another one dynamically.
+ *
+ * The destination DualView is not synchronized, as it is entirely
+ * overwritten.
+ *
+ * @tparam DualViewSource Type of the source DualView.
+ * @tparam DualViewDestination Type of the destination DualView.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the algorithm is executed on the
+ * device, otherwise on the host.
+ * @param source Source DualView.
+ * @param destination Destination DualView.
+ */
+template <
+    typename DualViewSource, typename DualViewDestination,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void copy(bool const isExecutedOnDevice, DualViewSource &source,
+          DualViewDestination &destination) {
+  impl::dispatchAlgorithm<DeviceExecutionSpace, DeviceMemorySpace,
+                          HostExecutionSpace, HostMemorySpace>(
+      isExecutedOnDevice, [&](auto const space, auto const memorySpace) {
+        using MemorySpace = std::remove_const_t<decltype(memorySpace)>;
+        Kokkos::Experimental::copy(space, getSyncedView<MemorySpace>(source),
+                                   getView<MemorySpace>(destination));
+        setModified<MemorySpace>(destination);
+      });
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_ALGORITHMS_HPP__
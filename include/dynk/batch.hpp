@@ -0,0 +1,260 @@
+#ifndef __DYNK_BATCH_HPP__
+#define __DYNK_BATCH_HPP__
+
+/**
+ * Batch of ranges.
+ *
+ * Launching many kernels on small ranges (e.g. patches of an AMR mesh) is
+ * bound by the launch latency and by the fences of the dynamic parallel
+ * constructs. This approach executes a list of ranges as a single flattened
+ * launch: a prefix sum of the sizes of the ranges gives an offset table, and
+ * each iteration of the flattened range finds its range with a binary search
+ * in that table. The kernel receives the index of the range and the index
+ * within that range.
+ */
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/sync_diagnostics.hpp"
+
+namespace dynk {
+
+/**
+ * List of ranges to be executed in a single launch by
+ * `dynk::parallel_for_batch`.
+ *
+ * The offset table is computed on construction and stored in DualViews, so
+ * that it is only transferred once to each side if the batch is reused for
+ * several launches.
+ */
+class RangeBatch {
+public:
+  using DualView = Kokkos::DualView<std::size_t *>;
+
+private:
+  /// Index of the first element of each range in the flattened range, and
+  /// total size as last value.
+  DualView mOffsets;
+  /// First index of each range.
+  DualView mBegins;
+
+  void fill(std::size_t const index, std::size_t const begin,
+            std::size_t const end) {
+    mBegins.h_view(index) = begin;
+    mOffsets.h_view(index + 1) =
+        mOffsets.h_view(index) + (end > begin ? end - begin : 0);
+  }
+
+  void setFilled() {
+    mOffsets.modify_host();
+    mBegins.modify_host();
+  }
+
+public:
+  /**
+   * Create a batch from pairs of begin and end indices.
+   *
+   * @param ranges Ranges, empty ones are allowed.
+   */
+  explicit RangeBatch(
+      std::vector<std::pair<std::size_t, std::size_t>> const &ranges)
+      : mOffsets("dynk batch offsets", ranges.size() + 1),
+        mBegins("dynk batch begins", ranges.size()) {
+    for (std::size_t index = 0; index < ranges.size(); index++) {
+      fill(index, ranges[index].first, ranges[index].second);
+    }
+    setFilled();
+  }
+
+  /**
+   * Create a batch from Dynk range policies.
+   *
+   * Only the begin and end indices of the policies are used.
+   *
+   * @tparam Traits Traits of the policies.
+   * @param policies Policies.
+   */
+  template <typename... Traits>
+  explicit RangeBatch(std::vector<RangePolicy<Traits...>> const &policies)
+      : mOffsets("dynk batch offsets", policies.size() + 1),
+        mBegins("dynk batch begins", policies.size()) {
+    for (std::size_t index = 0; index < policies.size(); index++) {
+      fill(index, policies[index].getBegin(), policies[index].getEnd());
+    }
+    setFilled();
+  }
+
+  /**
+   * Get the number of ranges.
+   */
+  std::size_t getRangesCount() const { return mBegins.extent(0); }
+
+  /**
+   * Get the total number of iterations.
+   */
+  std::size_t getSize() const { return mOffsets.h_view(getRangesCount()); }
+
+  DualView &getOffsets() { return mOffsets; }
+
+  DualView &getBegins() { return mBegins; }
+};
+
+namespace impl {
+
+/**
+ * Functor mapping an iteration of the flattened range to its range.
+ *
+ * @tparam View Type of the Views of the offset table.
+ * @tparam Kernel Type of the kernel.
+ */
+template <typename View, typename Kernel> struct BatchFunctor {
+  View mOffsets;
+  View mBegins;
+  Kernel mKernel;
+
+  BatchFunctor(View const &offsets, View const &begins, Kernel const &kernel)
+      : mOffsets(offsets), mBegins(begins), mKernel(kernel) {}
+
+  KOKKOS_FUNCTION void operator()(std::size_t const i) const {
+    // find the last range starting at or before i, empty ranges are skipped
+    std::size_t low = 0;
+    std::size_t high = mBegins.extent(0);
+    while (high - low > 1) {
+      std::size_t const middle = (low + high) / 2;
+      if (mOffsets(middle) <= i) {
+        low = middle;
+      } else {
+        high = middle;
+      }
+    }
+
+    mKernel(low, mBegins(low) + i - mOffsets(low));
+  }
+};
+
+/**
+ * Execute a batch on one side.
+ *
+ * @tparam ExecutionSpace Execution space of the launch.
+ * @tparam MemorySpace Memory space of the offset table.
+ * @tparam Kernel Type of the kernel.
+ * @param label Label of the kernel.
+ * @param batch Batch of ranges.
+ * @param kernel Kernel.
+ */
+template <typename ExecutionSpace, typename MemorySpace, typename Kernel>
+void launchBatch(std::string const &label, RangeBatch &batch,
+                 Kernel const &kernel) {
+  auto const offsets = getSyncedView<MemorySpace>(batch.getOffsets());
+  auto const begins = getSyncedView<MemorySpace>(batch.getBegins());
+
+  Kokkos::parallel_for(
+      label,
+      Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<std::size_t>>(
+          getSpace<ExecutionSpace>(), 0, batch.getSize()),
+      BatchFunctor<std::remove_const_t<decltype(offsets)>, Kernel>(
+          offsets, begins, kernel));
+}
+
+} // namespace impl
+
+/**
+ * Parallel for over a batch of ranges in a single launch, that can be
+ * executed dynamically on device or on host depending on a Boolean
+ * parameter.
+ *
+ * The kernel receives the index of the range in the batch, and the index
+ * within that range:
+ *
+ * ```cpp
+ * dynk::RangeBatch batch({{0, 10}, {100, 120}, {50, 53}});
+ * dynk::parallel_for_batch(
+ *     isExecutedOnDevice, "patches", batch,
+ *     KOKKOS_LAMBDA(std::size_t const patch, std::size_t const i) {
+ *       // ...
+ *     });
+ * ```
+ *
+ * @tparam Kernel Type of the kernel.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param batch Batch of ranges, which can be reused for several launches.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ */
+template <
+    typename Kernel,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void parallel_for_batch(bool const isExecutedOnDevice,
+                        std::string const &label, RangeBatch &batch,
+                        Kernel const &kernel) {
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic parallel for batch"));
+  double const start = impl::getPlacementTime();
+
+  if (isExecutedOnDevice) {
+    // device execution
+    impl::launchBatch<DeviceExecutionSpace, DeviceMemorySpace>(label, batch,
+                                                               kernel);
+  } else {
+    // host execution
+    impl::launchBatch<HostExecutionSpace, HostMemorySpace>(label, batch,
+                                                           kernel);
+  }
+
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic parallel for batch"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
+}
+
+/**
+ * Parallel for over a list of ranges in a single launch, that can be
+ * executed dynamically on device or on host depending on a Boolean
+ * parameter.
+ *
+ * The offset table is created for this launch only; prefer creating a
+ * `dynk::RangeBatch` if the same ranges are launched several times.
+ *
+ * @tparam Ranges Type of the list of ranges, a vector of pairs of indices or
+ * of Dynk range policies.
+ * @tparam Kernel Type of the kernel.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param ranges List of ranges.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ */
+template <typename Ranges, typename Kernel>
+void parallel_for_batch(bool const isExecutedOnDevice,
+                        std::string const &label, Ranges const &ranges,
+                        Kernel const &kernel) {
+  RangeBatch batch(ranges);
+  parallel_for_batch(isExecutedOnDevice, label, batch, kernel);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_BATCH_HPP__
@@ -0,0 +1,388 @@
+#ifndef __DYNK_COROUTINE_HPP__
+#define __DYNK_COROUTINE_HPP__
+
+/**
+ * Coroutine approach.
+ *
+ * This approach proposes an awaitable parallel for, which launches a kernel
+ * on an execution space instance of the chosen side dedicated to the calling
+ * thread, and resumes the awaiting coroutine once that instance completes,
+ * without fencing the other instances. Coroutines are driven by a
+ * single-threaded scheduler, so that a host-side driver can interleave
+ * independent host and device work:
+ *
+ * ```cpp
+ * dynk::Task step(bool const isExecutedOnDevice) {
+ *   auto launch = dynk::async_for(isExecutedOnDevice, "step", n, kernel);
+ *   // do something else
+ *   co_await launch;
+ * }
+ *
+ * dynk::Scheduler scheduler;
+ * scheduler.spawn(step(true));
+ * scheduler.spawn(step(false));
+ * scheduler.run();
+ * ```
+ *
+ * This approach requires C++20.
+ */
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+
+class Scheduler;
+
+namespace impl {
+
+/**
+ * Operation a suspended coroutine waits for.
+ */
+class Waitable {
+public:
+  virtual ~Waitable() = default;
+
+  /**
+   * Tell if the operation is complete, without blocking.
+   */
+  virtual bool isComplete() = 0;
+
+  /**
+   * Block until the operation is complete.
+   */
+  virtual void wait() = 0;
+};
+
+/**
+ * Tell if all the work submitted to an execution space instance is known to
+ * be complete, without blocking.
+ *
+ * The stream of the instance is queried for CUDA and HIP, and the work of a
+ * Serial, OpenMP or Threads instance is always complete, as their kernels are
+ * finished when their launch returns. Other backends (e.g. SYCL,
+ * OpenMPTarget or HPX) are asynchronous but provide no query, and their
+ * instances are reported as not complete: they are left to the scheduler,
+ * which blocks on them once they are the oldest operation and no coroutine is
+ * ready.
+ *
+ * @tparam ExecutionSpace Type of the execution space.
+ * @param space Execution space instance.
+ * @return `true` if the work is known to be complete.
+ */
+template <typename ExecutionSpace>
+bool isComplete(ExecutionSpace const &space) {
+#ifdef KOKKOS_ENABLE_CUDA
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Cuda>) {
+    return cudaStreamQuery(space.cuda_stream()) == cudaSuccess;
+  }
+#endif // ifdef KOKKOS_ENABLE_CUDA
+#ifdef KOKKOS_ENABLE_HIP
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::HIP>) {
+    return hipStreamQuery(space.hip_stream()) == hipSuccess;
+  }
+#endif // ifdef KOKKOS_ENABLE_HIP
+#ifdef KOKKOS_ENABLE_SERIAL
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Serial>) {
+    // kernels are executed synchronously
+    return true;
+  }
+#endif // ifdef KOKKOS_ENABLE_SERIAL
+#ifdef KOKKOS_ENABLE_OPENMP
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::OpenMP>) {
+    // kernels are executed synchronously
+    return true;
+  }
+#endif // ifdef KOKKOS_ENABLE_OPENMP
+#ifdef KOKKOS_ENABLE_THREADS
+  if constexpr (std::is_same_v<ExecutionSpace, Kokkos::Threads>) {
+    // kernels are executed synchronously
+    return true;
+  }
+#endif // ifdef KOKKOS_ENABLE_THREADS
+  static_cast<void>(space);
+  return false;
+}
+
+} // namespace impl
+
+/**
+ * Coroutine driven by a `dynk::Scheduler`.
+ *
+ * The coroutine does not start before it is spawned in a scheduler.
+ */
+class Task {
+public:
+  struct promise_type {
+    Scheduler *mScheduler = nullptr;
+    std::exception_ptr mException;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    void return_void() {}
+
+    void unhandled_exception() { mException = std::current_exception(); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+private:
+  Handle mHandle;
+
+public:
+  explicit Task(Handle const handle) : mHandle(handle) {}
+
+  Task(Task const &) = delete;
+  Task &operator=(Task const &) = delete;
+
+  Task(Task &&other) noexcept : mHandle(std::exchange(other.mHandle, {})) {}
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (mHandle) {
+        mHandle.destroy();
+      }
+      mHandle = std::exchange(other.mHandle, {});
+    }
+    return *this;
+  }
+
+  ~Task() {
+    if (mHandle) {
+      mHandle.destroy();
+    }
+  }
+
+  Handle getHandle() const { return mHandle; }
+
+  bool isDone() const { return !mHandle || mHandle.done(); }
+};
+
+/**
+ * Single-threaded scheduler of coroutines.
+ *
+ * Ready coroutines are resumed in order. Coroutines waiting for an operation
+ * are polled, and if no coroutine is ready, the scheduler blocks on the
+ * oldest operation.
+ */
+class Scheduler {
+  std::vector<Task> mTasks;
+  std::deque<std::coroutine_handle<>> mReady;
+  std::deque<std::pair<std::coroutine_handle<>, impl::Waitable *>> mWaiting;
+
+  void poll() {
+    for (auto waiting = mWaiting.begin(); waiting != mWaiting.end();) {
+      if (waiting->second->isComplete()) {
+        mReady.push_back(waiting->first);
+        waiting = mWaiting.erase(waiting);
+      } else {
+        waiting++;
+      }
+    }
+  }
+
+public:
+  Scheduler() = default;
+
+  Scheduler(Scheduler const &) = delete;
+  Scheduler &operator=(Scheduler const &) = delete;
+
+  /**
+   * Add a coroutine to execute at the next run.
+   *
+   * @param task Coroutine.
+   */
+  void spawn(Task task) {
+    task.getHandle().promise().mScheduler = this;
+    mReady.push_back(task.getHandle());
+    mTasks.push_back(std::move(task));
+  }
+
+  /**
+   * Suspend a coroutine until an operation is complete.
+   *
+   * @param handle Handle of the coroutine.
+   * @param waitable Operation, which must live until the coroutine resumes.
+   */
+  void suspend(std::coroutine_handle<> const handle,
+               impl::Waitable &waitable) {
+    mWaiting.emplace_back(handle, &waitable);
+  }
+
+  /**
+   * Execute all the spawned coroutines until they are done.
+   *
+   * The first exception thrown by a coroutine is rethrown once all of them
+   * are done.
+   */
+  void run() {
+    while (!mReady.empty() || !mWaiting.empty()) {
+      poll();
+
+      if (mReady.empty()) {
+        // nothing else to do, block on the oldest operation
+        mWaiting.front().second->wait();
+        mReady.push_back(mWaiting.front().first);
+        mWaiting.pop_front();
+      }
+
+      while (!mReady.empty()) {
+        auto const handle = mReady.front();
+        mReady.pop_front();
+        handle.resume();
+      }
+    }
+
+    std::vector<Task> tasks = std::move(mTasks);
+    mTasks.clear();
+    for (auto const &task : tasks) {
+      if (task.getHandle().promise().mException) {
+        std::rethrow_exception(task.getHandle().promise().mException);
+      }
+    }
+  }
+};
+
+/**
+ * Awaitable of a kernel launched on an execution space instance.
+ *
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution.
+ */
+template <typename DeviceExecutionSpace, typename HostExecutionSpace>
+class KernelAwaitable : public impl::Waitable {
+  bool mIsExecutedOnDevice;
+  DeviceExecutionSpace mDeviceSpace;
+  HostExecutionSpace mHostSpace;
+  bool mIsComplete = false;
+
+public:
+  KernelAwaitable(bool const isExecutedOnDevice,
+                  DeviceExecutionSpace const &deviceSpace,
+                  HostExecutionSpace const &hostSpace)
+      : mIsExecutedOnDevice(isExecutedOnDevice), mDeviceSpace(deviceSpace),
+        mHostSpace(hostSpace) {}
+
+  bool isComplete() override {
+    if (!mIsComplete) {
+      mIsComplete = mIsExecutedOnDevice ? impl::isComplete(mDeviceSpace)
+                                        : impl::isComplete(mHostSpace);
+    }
+    return mIsComplete;
+  }
+
+  void wait() override {
+    if (mIsExecutedOnDevice) {
+      mDeviceSpace.fence(DYNK_LABEL("dynk coroutine wait"));
+    } else {
+      mHostSpace.fence(DYNK_LABEL("dynk coroutine wait"));
+    }
+    mIsComplete = true;
+  }
+
+  /**
+   * Tell if the awaiting coroutine can continue without suspending, which is
+   * only the case if the kernel is already known to be complete, so that
+   * other coroutines get a chance to launch their work.
+   */
+  bool await_ready() const { return mIsComplete; }
+
+  void await_suspend(Task::Handle const handle) {
+    handle.promise().mScheduler->suspend(handle, *this);
+  }
+
+  void await_resume() const {}
+};
+
+/**
+ * Parallel for returning an awaitable, that can be executed dynamically on
+ * device or on host depending on a Boolean parameter.
+ *
+ * The kernel is launched immediately on the instance of the execution space
+ * of the chosen side dedicated to the calling thread, created on first use,
+ * without fencing before or after. Kernels launched on the same side by a
+ * thread are hence executed in order. Awaiting the
+ * returned object within a `dynk::Task` resumes the task once the instance
+ * completes. Data produced on the other side must hence be awaited before.
+ *
+ * Tile autotuning of `dynk::MDRangePolicy` is not used.
+ *
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @tparam Kernel Type of the kernel.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param executionPolicy Object containing the parameters to create a Kokkos
+ * execution policy.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region, or
+ * `dynk::KernelFactory` creating it.
+ * @return Awaitable of the kernel.
+ */
+template <
+    typename ExecutionPolicy, typename Kernel,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+KernelAwaitable<DeviceExecutionSpace, HostExecutionSpace>
+async_for(bool const isExecutedOnDevice, std::string const &label,
+          ExecutionPolicy const &executionPolicy, Kernel const &kernel) {
+  DeviceExecutionSpace deviceSpace;
+  HostExecutionSpace hostSpace;
+  // the kernel is not waited for, only its launch is timed
+  double const start = impl::getPlacementTime();
+
+  if (isExecutedOnDevice) {
+    // device execution
+    deviceSpace = impl::ThreadSpaces<DeviceExecutionSpace>::get().getSpace();
+    Kokkos::parallel_for(
+        label,
+        impl::getExecutionPolicy<DeviceExecutionSpace, true>(deviceSpace,
+                                                             executionPolicy),
+        impl::getKernel<DeviceMemorySpace>(kernel));
+  } else {
+    // host execution
+    hostSpace = impl::ThreadSpaces<HostExecutionSpace>::get().getSpace();
+    Kokkos::parallel_for(
+        label,
+        impl::getExecutionPolicy<HostExecutionSpace, false>(hostSpace,
+                                                            executionPolicy),
+        impl::getKernel<HostMemorySpace>(kernel));
+  }
+
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::recordPlacement(label, isExecutedOnDevice, start);
+  return {isExecutedOnDevice, deviceSpace, hostSpace};
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_COROUTINE_HPP__
@@ -1,11 +1,260 @@
 #ifndef __DUAL_VIEW_HPP__
 #define __DUAL_VIEW_HPP__
 
+/**
+ * DualView helpers.
+ *
+ * DualViews whose both sides are in the same memory space share a single
+ * allocation, for instance `dynk::SharedDualView` in `Kokkos::SharedSpace`.
+ * For them, the helpers never transfer data: synchronizing a side only
+ * fences if the other side was marked as modified, and optionally prefetches
+ * the data (see `dynk::enableSharedPrefetch`). The alias `dynk::DualView`
+ * designates `dynk::SharedDualView` if `DYNK_ENABLE_ZERO_COPY` is defined
+ * (with the CMake option of the same name), and a regular DualView otherwise.
+ *
+ * In thread-safe mode (see `thread_safety.hpp`), synchronizations and
+ * modification markers are done under a lock per DualView.
+ */
+
+#include <atomic>
+#include <type_traits>
+
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DualView.hpp>
 
+#include "dynk/label.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+#if defined(DYNK_ENABLE_ZERO_COPY) && !defined(KOKKOS_HAS_SHARED_SPACE)
+#error "Zero-copy mode requires Kokkos::SharedSpace"
+#endif // if defined(DYNK_ENABLE_ZERO_COPY) &&
+       // !defined(KOKKOS_HAS_SHARED_SPACE)
+
 namespace dynk {
 
+#ifdef KOKKOS_HAS_SHARED_SPACE
+
+/**
+ * DualView whose both sides share a single allocation in
+ * `Kokkos::SharedSpace`.
+ *
+ * @tparam DataType Data type of the DualView.
+ */
+template <typename DataType>
+using SharedDualView = Kokkos::DualView<DataType, Kokkos::SharedSpace>;
+
+#endif // ifdef KOKKOS_HAS_SHARED_SPACE
+
+#ifdef DYNK_ENABLE_ZERO_COPY
+
+/**
+ * DualView type of the build, sharing a single allocation for both sides in
+ * zero-copy mode.
+ *
+ * @tparam DataType Data type of the DualView.
+ */
+template <typename DataType> using DualView = SharedDualView<DataType>;
+
+#else
+
+/**
+ * DualView type of the build, a regular `Kokkos::DualView` mirroring its data
+ * between a device allocation and a host allocation, as
+ * `DYNK_ENABLE_ZERO_COPY` is not defined.
+ *
+ * @tparam DataType Data type of the DualView.
+ */
+template <typename DataType> using DualView = Kokkos::DualView<DataType>;
+
+#endif // ifdef DYNK_ENABLE_ZERO_COPY
+
+namespace impl {
+
+/**
+ * Tell if both sides of a DualView share a single allocation.
+ *
+ * This is the case if both sides are in the same memory space (e.g.
+ * `Kokkos::SharedSpace`, or the host memory space on a build without device),
+ * as the host View is then a mirror View of the device one.
+ *
+ * @tparam DualView Type of the DualView.
+ */
+template <typename DualView> constexpr bool isSingleAllocation() {
+  return std::is_same_v<typename DualView::t_dev::memory_space,
+                        typename DualView::t_host::memory_space>;
+}
+
+/**
+ * Tell if a memory space is the device side of a DualView.
+ *
+ * If both sides share a single allocation, only the default host memory space
+ * designates the host side.
+ *
+ * @tparam MemorySpace Memory space to check.
+ * @tparam DualView Type of the DualView.
+ */
+template <typename MemorySpace, typename DualView>
+constexpr bool isDeviceSide() {
+  if constexpr (isSingleAllocation<DualView>()) {
+    return !std::is_same_v<MemorySpace,
+                           Kokkos::DefaultHostExecutionSpace::memory_space>;
+  } else {
+    return !std::is_same_v<MemorySpace,
+                           typename DualView::t_host::memory_space>;
+  }
+}
+
+/**
+ * Get the flag telling if data of DualViews sharing a single allocation is
+ * prefetched when synchronized.
+ */
+inline std::atomic<bool> &getSharedPrefetch() {
+  static std::atomic<bool> isPrefetched = false;
+  return isPrefetched;
+}
+
+/**
+ * Prefetch the data of a View to one side, if supported by the backend.
+ *
+ * @tparam isForDevice If `true`, prefetch to the device, otherwise to the
+ * host.
+ * @tparam View Type of the View.
+ * @param view View to prefetch.
+ */
+template <bool isForDevice, typename View>
+void prefetch([[maybe_unused]] View const &view) {
+  [[maybe_unused]] std::size_t const bytes =
+      view.span() * sizeof(typename View::value_type);
+#if defined(KOKKOS_ENABLE_CUDA) && CUDART_VERSION < 13000
+  if constexpr (std::is_same_v<typename View::memory_space,
+                               Kokkos::CudaUVMSpace>) {
+    Kokkos::Cuda const space;
+    cudaMemPrefetchAsync(view.data(), bytes,
+                         isForDevice ? space.cuda_device() : cudaCpuDeviceId,
+                         space.cuda_stream());
+  }
+#elif defined(KOKKOS_ENABLE_HIP)
+  if constexpr (std::is_same_v<typename View::memory_space,
+                               Kokkos::HIPManagedSpace>) {
+    Kokkos::HIP const space;
+    hipMemPrefetchAsync(view.data(), bytes,
+                        isForDevice ? space.hip_device() : hipCpuDeviceId,
+                        space.hip_stream());
+  }
+#endif // if defined(KOKKOS_ENABLE_CUDA) && CUDART_VERSION < 13000
+}
+
+/**
+ * Synchronize a side of a DualView sharing a single allocation.
+ *
+ * No data is transferred: if the other side was marked as modified, its
+ * kernels are waited for.
+ *
+ * @tparam isForDevice If `true`, synchronize the device side, otherwise the
+ * host side.
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView to synchronize.
+ */
+template <bool isForDevice, typename DualView>
+void syncSingleAllocation(DualView &dualView) {
+  bool const isOutdated =
+      isForDevice ? dualView.need_sync_device() : dualView.need_sync_host();
+  if (!isOutdated) {
+    return;
+  }
+
+  fence<Kokkos::DefaultExecutionSpace, Kokkos::DefaultHostExecutionSpace>(
+      DYNK_LABEL("dynk shared dual view sync"));
+  dualView.clear_sync_state();
+
+  if (getSharedPrefetch()) {
+    prefetch<isForDevice>(dualView.view_device());
+  }
+}
+
+/**
+ * Tell if a container is a `Kokkos::DualView`.
+ *
+ * @tparam DualView Type of the container.
+ */
+template <typename DualView> struct IsKokkosDualView : std::false_type {};
+
+template <typename DataType, typename... Properties>
+struct IsKokkosDualView<Kokkos::DualView<DataType, Properties...>>
+    : std::true_type {};
+
+/**
+ * Synchronize a DualView for the requested memory space.
+ *
+ * @tparam MemorySpace Memory space requested.
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView to synchronize.
+ */
+template <typename MemorySpace, typename DualView>
+void sync(DualView &dualView) {
+  [[maybe_unused]] auto const lock = lockDualView(dualView);
+  if constexpr (isSingleAllocation<DualView>()) {
+    syncSingleAllocation<isDeviceSide<MemorySpace, DualView>()>(dualView);
+  } else {
+#ifdef DYNK_ENABLE_THREAD_SAFE
+    // copy in both directions on the device instance of the calling thread,
+    // instead of fencing globally
+    auto const space =
+        getSpace<typename DualView::t_dev::execution_space>();
+    if constexpr (!IsKokkosDualView<DualView>::value) {
+      // other containers (e.g. `dynk::LayoutDualView`) transfer on an
+      // instance themselves
+      if constexpr (isDeviceSide<MemorySpace, DualView>()) {
+        dualView.sync_device(space);
+      } else {
+        dualView.sync_host(space);
+      }
+    } else if constexpr (isDeviceSide<MemorySpace, DualView>()) {
+      dualView.sync_device(space);
+    } else if (dualView.need_sync_host()) {
+      // sync_host would copy on the default instance of the device
+      Kokkos::deep_copy(space, dualView.view_host(), dualView.view_device());
+      dualView.clear_sync_state();
+    }
+    space.fence(DYNK_LABEL("dynk dual view sync"));
+#else
+    dualView.template sync<MemorySpace>();
+#endif // ifdef DYNK_ENABLE_THREAD_SAFE
+  }
+}
+
+/**
+ * View in `Kokkos::AnonymousSpace` of a DualView.
+ *
+ * The View is built from the data type, layout and memory traits of the
+ * DualView, without its space arguments, as a View accepts a single memory
+ * space (e.g. for a DualView in `Kokkos::SharedSpace`).
+ *
+ * @tparam DualView Type of the DualView.
+ */
+template <typename DualView>
+using AnonymousView =
+    Kokkos::View<typename DualView::t_dev::data_type,
+                 typename DualView::t_dev::array_layout,
+                 Kokkos::AnonymousSpace,
+                 typename DualView::t_dev::memory_traits>;
+
+} // namespace impl
+
+/**
+ * Enable or disable the prefetch of the data of DualViews sharing a single
+ * allocation when they are synchronized.
+ *
+ * Prefetching is supported for the managed memory of CUDA and HIP, and
+ * ignored otherwise.
+ *
+ * @param isPrefetched If `true`, enable prefetching.
+ */
+inline void enableSharedPrefetch(bool const isPrefetched = true) {
+  impl::getSharedPrefetch() = isPrefetched;
+}
+
 /**
  * Get a View of a DualView for the requested memory space.
  *
@@ -20,7 +269,13 @@ namespace dynk {
  */
 template <typename MemorySpace, typename DualView>
 auto getView(DualView &dualView) {
-  return dualView.template view<MemorySpace>();
+  if constexpr (!impl::isSingleAllocation<DualView>()) {
+    return dualView.template view<MemorySpace>();
+  } else if constexpr (impl::isDeviceSide<MemorySpace, DualView>()) {
+    return dualView.view_device();
+  } else {
+    return dualView.view_host();
+  }
 }
 
 /**
@@ -37,13 +292,13 @@ auto getView(DualView &dualView) {
  * @param dualView DualView to take a view from.
  * @param isExecutedOnDevice If `true`, returns the device view, otherwise,
  * returns the host view.
- * @return View in the requested memory space.
+ * @return View in `Kokkos::AnonymousSpace` on the requested memory space.
  */
 template <
     typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
     typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space,
     typename T, typename... P>
-Kokkos::View<T, Kokkos::AnonymousSpace, P...>
+impl::AnonymousView<Kokkos::DualView<T, P...>>
 getView(Kokkos::DualView<T, P...> &dualView, bool const isExecutedOnDevice) {
   if (isExecutedOnDevice) {
     return getView<DeviceMemorySpace>(dualView);
@@ -66,13 +321,13 @@ getView(Kokkos::DualView<T, P...> &dualView, bool const isExecutedOnDevice) {
  * @param dualView DualView to take a view from.
  * @param isExecutedOnDevice If `true`, returns the device view, otherwise,
  * returns the host view.
- * @return View in the requested memory space.
+ * @return View in `Kokkos::AnonymousSpace` on the requested memory space.
  */
 template <
     typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
     typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space,
     typename T, typename... P>
-Kokkos::View<T, Kokkos::AnonymousSpace, P...>
+impl::AnonymousView<Kokkos::DualView<T, P...>>
 getView(Kokkos::DualView<T, P...> const &dualView,
         bool const isExecutedOnDevice) {
   if (isExecutedOnDevice) {
@@ -97,7 +352,9 @@ getView(Kokkos::DualView<T, P...> const &dualView,
  */
 template <typename MemorySpace, typename DualView>
 auto getSyncedView(DualView &dualView) {
-  dualView.template sync<MemorySpace>();
+  impl::recordSync(dualView, impl::isDeviceSide<MemorySpace, DualView>(),
+                   impl::isSingleAllocation<DualView>());
+  impl::sync<MemorySpace>(dualView);
   return getView<MemorySpace>(dualView);
 }
 
@@ -122,9 +379,14 @@ template <
     typename DualView>
 auto getSyncedView(DualView &dualView, bool const isExecutedOnDevice) {
   if (isExecutedOnDevice) {
-    dualView.template sync<DeviceMemorySpace>();
+    impl::recordSync(dualView,
+                     impl::isDeviceSide<DeviceMemorySpace, DualView>(),
+                     impl::isSingleAllocation<DualView>());
+    impl::sync<DeviceMemorySpace>(dualView);
   } else {
-    dualView.template sync<HostMemorySpace>();
+    impl::recordSync(dualView, impl::isDeviceSide<HostMemorySpace, DualView>(),
+                     impl::isSingleAllocation<DualView>());
+    impl::sync<HostMemorySpace>(dualView);
   }
   return getView<DeviceMemorySpace, HostMemorySpace>(dualView,
                                                      isExecutedOnDevice);
@@ -143,7 +405,16 @@ auto getSyncedView(DualView &dualView, bool const isExecutedOnDevice) {
  */
 template <typename MemorySpace, typename DualView>
 void setModified(DualView &dualView) {
-  dualView.template modify<MemorySpace>();
+  impl::recordModify(dualView, impl::isDeviceSide<MemorySpace, DualView>());
+  [[maybe_unused]] auto const lock = impl::lockDualView(dualView);
+  if constexpr (!impl::isSingleAllocation<DualView>()) {
+    dualView.template modify<MemorySpace>();
+  } else if constexpr (impl::isDeviceSide<MemorySpace, DualView>()) {
+    // only tracks that the device kernels must be waited for
+    dualView.modify_device();
+  } else {
+    dualView.modify_host();
+  }
 }
 
 /**
@@ -0,0 +1,159 @@
+#ifndef __DYNK_FIRST_TOUCH_HPP__
+#define __DYNK_FIRST_TOUCH_HPP__
+
+/**
+ * NUMA-aware first touch.
+ *
+ * On Linux, a memory page is placed on the NUMA node of the thread that
+ * touches it first. Kokkos initializes host allocations with a sequential
+ * memset, so all the pages of a host View end up on the node of the main
+ * thread, and host kernels on a multi-socket node run with remote memory
+ * accesses.
+ *
+ * The functions of this file allocate host Views without initialization,
+ * then initialize them with a parallel for on the host execution space, with
+ * the same Dynk execution policy as the host kernels using them
+ * (`dynk::RangePolicy` for 1D Views, `dynk::MDRangePolicy` otherwise). As
+ * these policies partition their range statically on the host, a host kernel
+ * iterating on the same range accesses pages local to its threads, provided
+ * threads are bound (e.g. with `OMP_PROC_BIND=spread` and
+ * `OMP_PLACES=threads` for OpenMP).
+ */
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/layer.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Functor value-initializing each element of an uninitialized View.
+ *
+ * Elements are constructed in place, as there is no object to assign to yet.
+ *
+ * @tparam View Type of the View.
+ */
+template <typename View> struct FirstTouchFunctor {
+  View mView;
+
+  explicit FirstTouchFunctor(View const &view) : mView(view) {}
+
+  template <typename... Indices>
+  KOKKOS_FUNCTION void operator()(Indices const... indices) const {
+    new (&mView(indices...)) typename View::value_type{};
+  }
+};
+
+} // namespace impl
+
+/**
+ * Value-initialize a host View in parallel, with the execution policy of the
+ * host kernels using it.
+ *
+ * Pages are placed like the kernels executed on the host with the same Dynk
+ * execution policy access them. The policy should cover the whole View, as
+ * other elements are not initialized. The tile of a `dynk::MDRangePolicy` is
+ * its host tile: an autotuned tile is only known once the kernel runs, so a
+ * host tile should be set for placement to match. This only has an effect on
+ * pages that were not touched yet, i.e. on Views allocated with
+ * `Kokkos::WithoutInitializing`.
+ *
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam View Type of the View.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @param view View to initialize.
+ * @param executionPolicy Execution policy of the host kernels using the View.
+ */
+template <typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+          typename View, typename ExecutionPolicy>
+void firstTouch(View const &view, ExecutionPolicy const &executionPolicy) {
+  Kokkos::parallel_for(
+      "dynk first touch",
+      impl::getExecutionPolicy<HostExecutionSpace, false>(
+          HostExecutionSpace(), executionPolicy),
+      impl::FirstTouchFunctor<View>(view));
+  HostExecutionSpace().fence("end of dynk first touch");
+}
+
+/**
+ * Value-initialize a host View in parallel, with the default execution policy
+ * of host kernels iterating over the whole View.
+ *
+ * A 1D View is initialized with a `dynk::RangePolicy` over its extent, and a
+ * multidimensional one with a `dynk::MDRangePolicy` over its extents with
+ * the default tile.
+ *
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam View Type of the View.
+ * @param view View to initialize.
+ */
+template <typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+          typename View>
+void firstTouch(View const &view) {
+  constexpr std::size_t rank = View::rank;
+  static_assert(rank >= 1 && rank <= 6,
+                "Only Views of rank 1 to 6 can be first touched");
+
+  if constexpr (rank == 1) {
+    firstTouch<HostExecutionSpace>(view, RangePolicy<>(0, view.extent(0)));
+  } else {
+    using Policy = MDRangePolicy<Kokkos::Rank<rank>>;
+    typename Policy::Point begin{};
+    typename Policy::Point end;
+    for (std::size_t dimension = 0; dimension < rank; dimension++) {
+      end[dimension] = view.extent(dimension);
+    }
+    firstTouch<HostExecutionSpace>(view, Policy(begin, end));
+  }
+}
+
+/**
+ * Create a DualView whose host View is first touched in parallel.
+ *
+ * This is a replacement for the DualView constructor taking a label and
+ * extents. Both Views are allocated without initialization, the host View is
+ * value-initialized with `dynk::firstTouch`, and the device View, if distinct,
+ * with `Kokkos::deep_copy`. Synchronizations to the host, with
+ * `dynk::getSyncedView` or otherwise, copy into the pages already placed.
+ *
+ * @tparam DualView Type of the DualView.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam Extents Type of the extents.
+ * @param label Label of the DualView.
+ * @param extents Extents of the DualView.
+ * @return DualView.
+ */
+template <typename DualView,
+          typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+          typename... Extents>
+DualView createDualView(std::string const &label, Extents const... extents) {
+  using DeviceView = typename DualView::t_dev;
+  using HostView = typename DualView::t_host;
+
+  DeviceView deviceView(Kokkos::view_alloc(Kokkos::WithoutInitializing, label),
+                        extents...);
+  HostView hostView = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing), deviceView);
+
+  firstTouch<HostExecutionSpace>(hostView);
+  if (deviceView.data() != hostView.data()) {
+    Kokkos::deep_copy(deviceView,
+                      typename DeviceView::non_const_value_type{});
+  }
+
+  return DualView(deviceView, hostView);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_FIRST_TOUCH_HPP__
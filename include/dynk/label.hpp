@@ -0,0 +1,114 @@
+#ifndef __DYNK_LABEL_HPP__
+#define __DYNK_LABEL_HPP__
+
+/**
+ * Interned labels.
+ *
+ * Kokkos parallel constructs and fences take their label as a
+ * `std::string const &`, so passing a string literal creates a temporary
+ * string for each launch, which is allocated on the heap if it does not fit
+ * in the small string buffer. For small kernels executed many times, this
+ * allocation is not negligible compared to the launch itself. This approach
+ * proposes labels that are created once and interned, which can be passed
+ * wherever a `std::string const &` is expected without any allocation:
+ *
+ * ```cpp
+ * dynk::parallel_for(isExecutedOnDevice, DYNK_LABEL("axpy"), n, kernel);
+ * ```
+ */
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Table of interned label names.
+ *
+ * Names are stored in a node-based container, so that references to them
+ * remain valid for the whole execution.
+ */
+class LabelTable {
+  std::set<std::string, std::less<>> mNames;
+  std::mutex mMutex;
+
+  LabelTable() = default;
+
+public:
+  LabelTable(LabelTable const &) = delete;
+  LabelTable &operator=(LabelTable const &) = delete;
+
+  static LabelTable &get() {
+    static LabelTable table;
+    return table;
+  }
+
+  /**
+   * Get the interned copy of a name, inserting it if needed.
+   *
+   * @param name Name.
+   * @return Reference to the interned name.
+   */
+  std::string const &intern(std::string_view const name) {
+    std::lock_guard<std::mutex> const lock(mMutex);
+    auto const found = mNames.find(name);
+    if (found != mNames.end()) {
+      return *found;
+    }
+    return *mNames.emplace(name).first;
+  }
+
+  /**
+   * Get the number of interned names.
+   */
+  std::size_t getSize() {
+    std::lock_guard<std::mutex> const lock(mMutex);
+    return mNames.size();
+  }
+};
+
+} // namespace impl
+
+/**
+ * Label interned on creation, that converts to `std::string const &` without
+ * allocating.
+ *
+ * Creating a label looks up the table of interned names, so labels should be
+ * created once and reused, for instance as static variables, or with
+ * `DYNK_LABEL` which does so for each call site. Two labels with the same
+ * name refer to the same interned string.
+ */
+class Label {
+  std::string const *mName;
+
+public:
+  explicit Label(std::string_view const name)
+      : mName(&impl::LabelTable::get().intern(name)) {}
+
+  std::string const &getName() const { return *mName; }
+
+  operator std::string const &() const { return *mName; }
+
+  bool operator==(Label const &other) const { return mName == other.mName; }
+
+  bool operator!=(Label const &other) const { return mName != other.mName; }
+};
+
+} // namespace dynk
+
+/**
+ * Get a label created once for the call site.
+ *
+ * @param name Name of the label, usually a string literal.
+ * @return Reference to the label.
+ */
+#define DYNK_LABEL(name)                                                       \
+  ([]() -> ::dynk::Label const & {                                             \
+    static ::dynk::Label const label(name);                                    \
+    return label;                                                              \
+  }())
+
+#endif // ifndef __DYNK_LABEL_HPP__
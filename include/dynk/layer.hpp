@@ -21,73 +21,430 @@
  */
 
 #include <string>
+#include <tuple>
+#include <type_traits>
 
 #include <Kokkos_Core.hpp>
 
 #include "dynk/dual_view.hpp"
+#include "dynk/label.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/thread_safety.hpp"
+#include "dynk/tile_tuning.hpp"
 
 namespace dynk {
 
+/**
+ * Execution policy traits only used for device execution.
+ *
+ * @tparam Traits Kokkos execution policy traits (e.g.
+ * `Kokkos::LaunchBounds<256>`).
+ */
+template <typename... Traits> struct DeviceTraits {};
+
+/**
+ * Execution policy traits only used for host execution.
+ *
+ * @tparam Traits Kokkos execution policy traits (e.g.
+ * `Kokkos::Schedule<Kokkos::Dynamic>`).
+ */
+template <typename... Traits> struct HostTraits {};
+
+namespace impl {
+
+/**
+ * Concatenate the types of several tuples.
+ */
+template <typename... Tuples> struct ConcatTraits;
+
+template <typename... T> struct ConcatTraits<std::tuple<T...>> {
+  using type = std::tuple<T...>;
+};
+
+template <typename... T, typename... U, typename... Tuples>
+struct ConcatTraits<std::tuple<T...>, std::tuple<U...>, Tuples...> {
+  using type = typename ConcatTraits<std::tuple<T..., U...>, Tuples...>::type;
+};
+
+/**
+ * Keep a trait if it applies to the requested side.
+ *
+ * Traits not wrapped in `dynk::DeviceTraits` or `dynk::HostTraits` apply to
+ * both sides.
+ */
+template <bool isForDevice, typename Trait> struct SideTrait {
+  using type = std::tuple<Trait>;
+};
+
+template <bool isForDevice, typename... Traits>
+struct SideTrait<isForDevice, DeviceTraits<Traits...>> {
+  using type =
+      std::conditional_t<isForDevice, std::tuple<Traits...>, std::tuple<>>;
+};
+
+template <bool isForDevice, typename... Traits>
+struct SideTrait<isForDevice, HostTraits<Traits...>> {
+  using type =
+      std::conditional_t<isForDevice, std::tuple<>, std::tuple<Traits...>>;
+};
+
+template <template <typename...> class Policy, typename Tuple>
+struct ApplyTraits;
+
+template <template <typename...> class Policy, typename... Traits>
+struct ApplyTraits<Policy, std::tuple<Traits...>> {
+  using type = Policy<Traits...>;
+};
+
+/**
+ * Kokkos execution policy type with the traits of the requested side.
+ *
+ * @tparam Policy Kokkos execution policy template.
+ * @tparam isForDevice If `true`, keep device traits, otherwise keep host
+ * traits.
+ * @tparam Traits Traits of the execution policy, including the execution
+ * space.
+ */
+template <template <typename...> class Policy, bool isForDevice,
+          typename... Traits>
+using KokkosPolicy = typename ApplyTraits<
+    Policy, typename ConcatTraits<
+                std::tuple<>,
+                typename SideTrait<isForDevice, Traits>::type...>::type>::type;
+
+} // namespace impl
+
 /**
  * Store parameters to create a `Kokkos::RangePolicy`.
+ *
+ * Traits are forwarded to the Kokkos execution policy. Traits wrapped in
+ * `dynk::DeviceTraits` or `dynk::HostTraits` are only used for the
+ * corresponding side, so that for instance a dynamic schedule is used on the
+ * host and launch bounds on the device:
+ *
+ * ```cpp
+ * dynk::RangePolicy<
+ *     dynk::HostTraits<Kokkos::Schedule<Kokkos::Dynamic>>,
+ *     dynk::DeviceTraits<Kokkos::LaunchBounds<256>>>(0, n)
+ *     .setHostChunkSize(64);
+ * ```
+ *
+ * @tparam Traits Kokkos execution policy traits.
  */
-class RangePolicy {
+template <typename... Traits> class RangePolicy {
   std::size_t mBegin;
   std::size_t mEnd;
+  std::size_t mDeviceChunkSize = 0;
+  std::size_t mHostChunkSize = 0;
 
 public:
   RangePolicy(std::size_t const begin, std::size_t const end)
       : mBegin(begin), mEnd(end) {}
 
+  std::size_t getBegin() const { return mBegin; }
+
+  std::size_t getEnd() const { return mEnd; }
+
+  /**
+   * Set the chunk size for both sides.
+   *
+   * @param chunkSize Chunk size, 0 lets Kokkos decide.
+   * @return Reference to the policy.
+   */
+  RangePolicy &setChunkSize(std::size_t const chunkSize) {
+    mDeviceChunkSize = chunkSize;
+    mHostChunkSize = chunkSize;
+    return *this;
+  }
+
+  /**
+   * Set the chunk size for device execution.
+   *
+   * @param chunkSize Chunk size, 0 lets Kokkos decide.
+   * @return Reference to the policy.
+   */
+  RangePolicy &setDeviceChunkSize(std::size_t const chunkSize) {
+    mDeviceChunkSize = chunkSize;
+    return *this;
+  }
+
+  /**
+   * Set the chunk size for host execution.
+   *
+   * @param chunkSize Chunk size, 0 lets Kokkos decide.
+   * @return Reference to the policy.
+   */
+  RangePolicy &setHostChunkSize(std::size_t const chunkSize) {
+    mHostChunkSize = chunkSize;
+    return *this;
+  }
+
+  /**
+   * Create a `Kokkos::RangePolicy` on an execution space instance.
+   *
+   * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits and values, otherwise with the host ones.
+   * @param space Execution space instance.
+   * @return Execution policy.
+   */
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy(ExecutionSpace const &space) const {
+    using Policy = impl::KokkosPolicy<Kokkos::RangePolicy, isForDevice,
+                                      ExecutionSpace, Traits...>;
+    using IndexType = typename Policy::index_type;
+
+    Policy policy(space, static_cast<IndexType>(mBegin),
+                  static_cast<IndexType>(mEnd));
+
+    std::size_t const chunkSize =
+        isForDevice ? mDeviceChunkSize : mHostChunkSize;
+    if (chunkSize > 0) {
+      policy.set_chunk_size(chunkSize);
+    }
+
+    return policy;
+  }
+
   /**
-   * Create a `Kokkor::RangePolicy`.
+   * Create a `Kokkos::RangePolicy`.
    *
    * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits and values, otherwise with the host ones.
    * @return Execution policy.
    */
-  template <typename ExecutionSpace> auto getExecutionPolicy() const {
-    return Kokkos::RangePolicy<ExecutionSpace>(mBegin, mEnd);
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy() const {
+    return getExecutionPolicy<ExecutionSpace, isForDevice>(ExecutionSpace());
   }
 };
 
 /**
  * Store parameters to create a `Kokkos::MDRangePolicy`.
  *
+ * Traits are forwarded to the Kokkos execution policy, in the same way as for
+ * `dynk::RangePolicy`. Tiles can be set per side, as the optimal tiles for
+ * the host and for the device are usually very different. A null tile lets
+ * Kokkos decide.
+ *
+ * Tile autotuning can be enabled with `enableTileAutotuning`, in which case
+ * the tile is searched for each label, side and extents of the range during
+ * the first calls of `dynk::parallel_for` and `dynk::parallel_reduce`. Each
+ * call is executed once with a candidate tile, so the kernel results are not
+ * altered, and the fastest tile is used for the subsequent calls.
+ *
  * @tparam rank Rank of the multidimensional range.
+ * @tparam Traits Kokkos execution policy traits.
  */
-template <typename Rank> class MDRangePolicy {
-  Kokkos::Array<std::size_t, Rank::rank> mBegin;
-  Kokkos::Array<std::size_t, Rank::rank> mEnd;
-  Kokkos::Array<std::size_t, Rank::rank> mTile;
+template <typename Rank, typename... Traits> class MDRangePolicy {
+public:
+  using Point = Kokkos::Array<std::size_t, Rank::rank>;
+
+private:
+  Point mBegin;
+  Point mEnd;
+  Point mDeviceTile;
+  Point mHostTile;
+  bool mIsTileAutotuned = false;
 
 public:
-  MDRangePolicy(Kokkos::Array<std::size_t, Rank::rank> begin,
-                Kokkos::Array<std::size_t, Rank::rank> end,
-                Kokkos::Array<std::size_t, Rank::rank> tile = {})
-      : mBegin(begin), mEnd(end), mTile(tile) {}
+  MDRangePolicy(Point begin, Point end, Point tile = {})
+      : mBegin(begin), mEnd(end), mDeviceTile(tile), mHostTile(tile) {}
+
+  /**
+   * Set the tile for device execution.
+   *
+   * @param tile Tile.
+   * @return Reference to the policy.
+   */
+  MDRangePolicy &setDeviceTile(Point const tile) {
+    mDeviceTile = tile;
+    return *this;
+  }
+
+  /**
+   * Set the tile for host execution.
+   *
+   * @param tile Tile.
+   * @return Reference to the policy.
+   */
+  MDRangePolicy &setHostTile(Point const tile) {
+    mHostTile = tile;
+    return *this;
+  }
+
+  /**
+   * Enable or disable tile autotuning, which supersedes the tiles set.
+   *
+   * @param isTileAutotuned If `true`, enable tile autotuning.
+   * @return Reference to the policy.
+   */
+  MDRangePolicy &enableTileAutotuning(bool const isTileAutotuned = true) {
+    mIsTileAutotuned = isTileAutotuned;
+    return *this;
+  }
+
+  bool isTileAutotuned() const { return mIsTileAutotuned; }
+
+  /**
+   * Get the extents of the range.
+   *
+   * @return Extents.
+   */
+  Point getExtents() const {
+    Point extents;
+    for (std::size_t dimension = 0; dimension < Rank::rank; dimension++) {
+      extents[dimension] = mEnd[dimension] - mBegin[dimension];
+    }
+    return extents;
+  }
+
+  /**
+   * Create a `Kokkos::MDRangePolicy` on an execution space instance with a
+   * given tile.
+   *
+   * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits, otherwise with the host ones.
+   * @param space Execution space instance.
+   * @param tile Tile.
+   * @return Execution policy.
+   */
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy(ExecutionSpace const &space,
+                          Point const &tile) const {
+    using Policy = impl::KokkosPolicy<Kokkos::MDRangePolicy, isForDevice,
+                                      ExecutionSpace, Rank, Traits...>;
+
+    return Policy(space, mBegin, mEnd, tile);
+  }
+
+  /**
+   * Create a `Kokkos::MDRangePolicy` with a given tile.
+   *
+   * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits, otherwise with the host ones.
+   * @param tile Tile.
+   * @return Execution policy.
+   */
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy(Point const &tile) const {
+    return getExecutionPolicy<ExecutionSpace, isForDevice>(ExecutionSpace(),
+                                                           tile);
+  }
 
   /**
-   * Create a `Kokkor::MDRangePolicy`.
+   * Create a `Kokkos::MDRangePolicy` on an execution space instance.
    *
    * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits and tile, otherwise with the host ones.
+   * @param space Execution space instance.
    * @return Execution policy.
    */
-  template <typename ExecutionSpace> auto getExecutionPolicy() const {
-    return Kokkos::MDRangePolicy<ExecutionSpace, Rank>(mBegin, mEnd, mTile);
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy(ExecutionSpace const &space) const {
+    return getExecutionPolicy<ExecutionSpace, isForDevice>(
+        space, isForDevice ? mDeviceTile : mHostTile);
+  }
+
+  /**
+   * Create a `Kokkos::MDRangePolicy`.
+   *
+   * @tparam ExecutionSpace Execution space of the execution policy.
+   * @tparam isForDevice If `true`, the execution policy is created with the
+   * device traits and tile, otherwise with the host ones.
+   * @return Execution policy.
+   */
+  template <typename ExecutionSpace, bool isForDevice>
+  auto getExecutionPolicy() const {
+    return getExecutionPolicy<ExecutionSpace, isForDevice>(ExecutionSpace());
+  }
+};
+
+/**
+ * Kernel factory that creates a kernel for the memory space of the chosen
+ * side.
+ *
+ * Views obtained with the dynamic signature of `dynk::getView` are in
+ * `Kokkos::AnonymousSpace`, whose memory space is unknown at compile time.
+ * Instead, a kernel factory is a callable receiving an instance of the memory
+ * space of the chosen side, which can take correctly typed views from it and
+ * return the kernel to execute:
+ *
+ * ```cpp
+ * dynk::parallel_for(
+ *     isExecutedOnDevice, "label", dynk::RangePolicy(0, 10),
+ *     dynk::KernelFactory([&](auto memorySpace) {
+ *       auto dataV = dynk::getSyncedView<decltype(memorySpace)>(dataDV);
+ *       return Functor(dataV);
+ *     }));
+ * ```
+ *
+ * The factory is only called for the chosen side, right before the kernel
+ * is launched. Note that, as with the wrapper lambda approach, NVCC does not
+ * allow to return an extended lambda from the factory, as it is a generic
+ * lambda.
+ *
+ * @tparam Factory Type of the callable.
+ */
+template <typename Factory> class KernelFactory {
+  Factory mFactory;
+
+public:
+  explicit KernelFactory(Factory const &factory) : mFactory(factory) {}
+
+  /**
+   * Create the kernel for a memory space.
+   *
+   * @tparam MemorySpace Memory space of the views of the kernel.
+   * @return Kernel.
+   */
+  template <typename MemorySpace> auto getKernel() const {
+    return mFactory(MemorySpace{});
   }
 };
 
 namespace impl {
 
+/**
+ * Get a kernel as is.
+ *
+ * @tparam MemorySpace Unused.
+ * @tparam Kernel Type of the kernel.
+ * @param kernel Kernel.
+ * @return Kernel.
+ */
+template <typename MemorySpace, typename Kernel>
+Kernel const &getKernel(Kernel const &kernel) {
+  return kernel;
+}
+
+/**
+ * Get a kernel from a kernel factory.
+ *
+ * @tparam MemorySpace Memory space of the views of the kernel.
+ * @tparam Factory Type of the callable of the kernel factory.
+ * @param kernelFactory Kernel factory.
+ * @return Kernel.
+ */
+template <typename MemorySpace, typename Factory>
+auto getKernel(KernelFactory<Factory> const &kernelFactory) {
+  return kernelFactory.template getKernel<MemorySpace>();
+}
+
 /**
  * Get a Kokkos execution policy from an integer.
  *
  * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice Unused.
  * @tparam SizeType Type of the indexes.
  * @param end Last iteration to perform.
  * @return Single-dimension execution policy.
  */
-template <typename ExecutionSpace, typename SizeType,
+template <typename ExecutionSpace, bool isForDevice, typename SizeType,
           typename Enable = std::enable_if_t<std::is_integral_v<SizeType>>>
 auto getExecutionPolicy(SizeType const end) {
   return Kokkos::RangePolicy<ExecutionSpace>(0, end);
@@ -97,15 +454,176 @@ auto getExecutionPolicy(SizeType const end) {
  * Get a Kokkos execution policy from a Dynk execution policy.
  *
  * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice If `true`, use the device traits of the Dynk execution
+ * policy, otherwise the host ones.
  * @tparam ExecutionPolicy Type of the Dynk execution policy.
  * @param executionPolicy Dynk execution policy.
  * @return Execution policy.
  */
 template <
-    typename ExecutionSpace, typename ExecutionPolicy,
+    typename ExecutionSpace, bool isForDevice, typename ExecutionPolicy,
     typename Enable = std::enable_if_t<!std::is_integral_v<ExecutionPolicy>>>
 auto getExecutionPolicy(ExecutionPolicy const &executionPolicy) {
-  return executionPolicy.template getExecutionPolicy<ExecutionSpace>();
+  return executionPolicy
+      .template getExecutionPolicy<ExecutionSpace, isForDevice>();
+}
+
+/**
+ * Get a Kokkos execution policy on an execution space instance from an
+ * integer.
+ *
+ * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice Unused.
+ * @tparam SizeType Type of the indexes.
+ * @param space Execution space instance.
+ * @param end Last iteration to perform.
+ * @return Single-dimension execution policy.
+ */
+template <typename ExecutionSpace, bool isForDevice, typename SizeType,
+          typename Enable = std::enable_if_t<std::is_integral_v<SizeType>>>
+auto getExecutionPolicy(ExecutionSpace const &space, SizeType const end) {
+  return Kokkos::RangePolicy<ExecutionSpace>(space, 0, end);
+}
+
+/**
+ * Get a Kokkos execution policy on an execution space instance from a Dynk
+ * execution policy.
+ *
+ * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice If `true`, use the device traits of the Dynk execution
+ * policy, otherwise the host ones.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @param space Execution space instance.
+ * @param executionPolicy Dynk execution policy.
+ * @return Execution policy.
+ */
+template <
+    typename ExecutionSpace, bool isForDevice, typename ExecutionPolicy,
+    typename Enable = std::enable_if_t<!std::is_integral_v<ExecutionPolicy>>>
+auto getExecutionPolicy(ExecutionSpace const &space,
+                        ExecutionPolicy const &executionPolicy) {
+  return executionPolicy
+      .template getExecutionPolicy<ExecutionSpace, isForDevice>(space);
+}
+
+/**
+ * Maximum number of points in a tile tried by autotuning on the device, if the
+ * execution policy has no launch bounds.
+ */
+constexpr std::size_t maxTotalTileSizeDevice = 256;
+
+/**
+ * Maximum number of points in a tile tried by autotuning on the host.
+ */
+constexpr std::size_t maxTotalTileSizeHost = 4096;
+
+/**
+ * Get the maximum number of points in a tile tried by autotuning.
+ *
+ * On the device, each point of a tile is a thread of a block, so the maximum
+ * number of threads per block of the launch bounds of the execution policy is
+ * used, if set.
+ *
+ * @tparam Policy Type of the Kokkos execution policy.
+ * @tparam isForDevice If `true`, get the maximum for the device, otherwise
+ * for the host.
+ * @return Maximum number of points.
+ */
+template <typename Policy, bool isForDevice>
+constexpr std::size_t getMaxTotalTileSize() {
+  if constexpr (isForDevice) {
+    constexpr std::size_t maxThreads = Policy::launch_bounds::maxTperB;
+    return maxThreads > 0 ? maxThreads : maxTotalTileSizeDevice;
+  } else {
+    return maxTotalTileSizeHost;
+  }
+}
+
+/**
+ * Launch a parallel construct with a Dynk execution policy.
+ *
+ * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice If `true`, use the device parameters of the Dynk
+ * execution policy, otherwise the host ones.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @tparam Launcher Type of the launcher.
+ * @param label Label of the kernel.
+ * @param space Execution space instance.
+ * @param executionPolicy Dynk execution policy.
+ * @param launcher Functor launching the parallel construct for the Kokkos
+ * execution policy it receives.
+ */
+template <typename ExecutionSpace, bool isForDevice, typename ExecutionPolicy,
+          typename Launcher>
+void launch(std::string const &, ExecutionSpace const &space,
+            ExecutionPolicy const &executionPolicy, Launcher const &launcher) {
+  launcher(
+      getExecutionPolicy<ExecutionSpace, isForDevice>(space, executionPolicy));
+}
+
+/**
+ * Launch a parallel construct with a Dynk multidimensional execution policy,
+ * autotuning its tile if requested.
+ *
+ * @tparam ExecutionSpace Execution space of the execution policy.
+ * @tparam isForDevice If `true`, use the device parameters of the Dynk
+ * execution policy, otherwise the host ones.
+ * @tparam Rank Rank of the multidimensional range.
+ * @tparam Traits Traits of the Dynk execution policy.
+ * @tparam Launcher Type of the launcher.
+ * @param label Label of the kernel.
+ * @param space Execution space instance.
+ * @param executionPolicy Dynk execution policy.
+ * @param launcher Functor launching the parallel construct for the Kokkos
+ * execution policy it receives.
+ */
+template <typename ExecutionSpace, bool isForDevice, typename Rank,
+          typename... Traits, typename Launcher>
+void launch(std::string const &label, ExecutionSpace const &space,
+            MDRangePolicy<Rank, Traits...> const &executionPolicy,
+            Launcher const &launcher) {
+  if (!executionPolicy.isTileAutotuned()) {
+    launcher(executionPolicy
+                 .template getExecutionPolicy<ExecutionSpace, isForDevice>(
+                     space));
+    return;
+  }
+
+  using Tuner = TileTuner<Rank::rank>;
+  using Point = typename MDRangePolicy<Rank, Traits...>::Point;
+
+  auto const extentsPoint = executionPolicy.getExtents();
+  typename Tuner::Tile extents;
+  for (std::size_t dimension = 0; dimension < Rank::rank; dimension++) {
+    extents[dimension] = extentsPoint[dimension];
+  }
+
+  using Policy = decltype(
+      executionPolicy.template getExecutionPolicy<ExecutionSpace, isForDevice>(
+          space));
+  auto const [tile, isTimed] =
+      Tuner::get().getTile(label, isForDevice, extents,
+                           getMaxTotalTileSize<Policy, isForDevice>());
+
+  Point tilePoint;
+  for (std::size_t dimension = 0; dimension < Rank::rank; dimension++) {
+    tilePoint[dimension] = tile[dimension];
+  }
+
+  auto const policy =
+      executionPolicy.template getExecutionPolicy<ExecutionSpace, isForDevice>(
+          space, tilePoint);
+
+  if (!isTimed) {
+    launcher(policy);
+    return;
+  }
+
+  space.fence(DYNK_LABEL("begin of dynamic tile autotuning"));
+  Kokkos::Timer timer;
+  launcher(policy);
+  space.fence(DYNK_LABEL("end of dynamic tile autotuning"));
+  Tuner::get().record(label, isForDevice, extents, tile, timer.seconds());
 }
 
 } // namespace impl
@@ -114,6 +632,9 @@ auto getExecutionPolicy(ExecutionPolicy const &executionPolicy) {
  * Parallel for that can be executed dynamically on device or on host
  * depending on a Boolean parameter.
  *
+ * In thread-safe mode, the kernel is launched on the execution space
+ * instance of the calling thread (see `thread_safety.hpp`).
+ *
  * @tparam ExecutionPolicy Type of the Dynk execution policy.
  * @tparam Kernel Type of the kernel.
  * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
@@ -125,7 +646,8 @@ auto getExecutionPolicy(ExecutionPolicy const &executionPolicy) {
  * @param label Label of the kernel.
  * @param executionPolicy Object containing the parameters to create a Kokkos
  * execution policy.
- * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region, or
+ * `dynk::KernelFactory` creating it.
  */
 template <
     typename ExecutionPolicy, typename Kernel,
@@ -136,27 +658,41 @@ template <
 void parallel_for(bool const isExecutedOnDevice, std::string const &label,
                   ExecutionPolicy const &executionPolicy,
                   Kernel const &kernel) {
-  Kokkos::fence("begin of dynamic parallel for");
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic parallel for"));
+  double const start = impl::getPlacementTime();
 
   if (isExecutedOnDevice) {
     // device execution
-    Kokkos::parallel_for(
-        label, impl::getExecutionPolicy<DeviceExecutionSpace>(executionPolicy),
-        kernel);
+    auto const &deviceKernel = impl::getKernel<DeviceMemorySpace>(kernel);
+    impl::launch<DeviceExecutionSpace, true>(
+        label, impl::getSpace<DeviceExecutionSpace>(), executionPolicy,
+        [&](auto const &policy) {
+          Kokkos::parallel_for(label, policy, deviceKernel);
+        });
   } else {
     // host execution
-    Kokkos::parallel_for(
-        label, impl::getExecutionPolicy<HostExecutionSpace>(executionPolicy),
-        kernel);
+    auto const &hostKernel = impl::getKernel<HostMemorySpace>(kernel);
+    impl::launch<HostExecutionSpace, false>(
+        label, impl::getSpace<HostExecutionSpace>(), executionPolicy,
+        [&](auto const &policy) {
+          Kokkos::parallel_for(label, policy, hostKernel);
+        });
   }
 
-  Kokkos::fence("end of dynamic parallel for");
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic parallel for"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
 }
 
 /**
  * Parallel reduce that can be executed dynamically on device or on host
  * depending on a Boolean parameter.
  *
+ * In thread-safe mode, the kernel is launched on the execution space
+ * instance of the calling thread (see `thread_safety.hpp`).
+ *
  * @tparam ExecutionPolicy Type of the Dynk execution policy.
  * @tparam Kernel Type of the kernel.
  * @tparam Reducer Type of the reducers.
@@ -169,7 +705,8 @@ void parallel_for(bool const isExecutedOnDevice, std::string const &label,
  * @param label Label of the kernel.
  * @param executionPolicy Object containing the parameters to create a Kokkos
  * execution policy.
- * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region, or
+ * `dynk::KernelFactory` creating it.
  * @param reducers All reducers to use.
  */
 template <
@@ -181,21 +718,32 @@ template <
 void parallel_reduce(bool const isExecutedOnDevice, std::string const &label,
                      ExecutionPolicy const &executionPolicy,
                      Kernel const &kernel, Reducer &...reducers) {
-  Kokkos::fence("begin of dynamic parallel reduce");
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic parallel reduce"));
+  double const start = impl::getPlacementTime();
 
   if (isExecutedOnDevice) {
     // device execution
-    Kokkos::parallel_reduce(
-        label, impl::getExecutionPolicy<DeviceExecutionSpace>(executionPolicy),
-        kernel, reducers...);
+    auto const &deviceKernel = impl::getKernel<DeviceMemorySpace>(kernel);
+    impl::launch<DeviceExecutionSpace, true>(
+        label, impl::getSpace<DeviceExecutionSpace>(), executionPolicy,
+        [&](auto const &policy) {
+          Kokkos::parallel_reduce(label, policy, deviceKernel, reducers...);
+        });
   } else {
     // host execution
-    Kokkos::parallel_reduce(
-        label, impl::getExecutionPolicy<HostExecutionSpace>(executionPolicy),
-        kernel, reducers...);
+    auto const &hostKernel = impl::getKernel<HostMemorySpace>(kernel);
+    impl::launch<HostExecutionSpace, false>(
+        label, impl::getSpace<HostExecutionSpace>(), executionPolicy,
+        [&](auto const &policy) {
+          Kokkos::parallel_reduce(label, policy, hostKernel, reducers...);
+        });
   }
 
-  Kokkos::fence("end of dynamic parallel reduce");
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic parallel reduce"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
 }
 
 } // namespace dynk
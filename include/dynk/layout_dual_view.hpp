@@ -0,0 +1,400 @@
+#ifndef __DYNK_LAYOUT_DUAL_VIEW_HPP__
+#define __DYNK_LAYOUT_DUAL_VIEW_HPP__
+
+/**
+ * Dual container with a different layout per side.
+ *
+ * `Kokkos::DualView` uses the same layout for its host and device Views,
+ * whereas host kernels usually prefer `Kokkos::LayoutRight` and device
+ * kernels `Kokkos::LayoutLeft`. `dynk::LayoutDualView` proposes the same
+ * interface as a DualView, with a layout chosen independently for each side,
+ * the synchronization performing a parallel tiled transpose on the device.
+ *
+ * The helpers of `dual_view.hpp` taking a memory space as template argument
+ * return Views with the layout of the requested side; used within a
+ * `dynk::KernelFactory`, kernels hence get correctly laid out Views. The
+ * helpers taking a Boolean value return a `Kokkos::LayoutStride` View in
+ * `Kokkos::AnonymousSpace`, as the layout differs between sides.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/dual_view.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Functor copying elements between two Views of different layouts.
+ *
+ * @tparam Destination Type of the destination View.
+ * @tparam Source Type of the source View.
+ */
+template <typename Destination, typename Source> struct TransposeFunctor {
+  Destination mDestination;
+  Source mSource;
+
+  TransposeFunctor(Destination const &destination, Source const &source)
+      : mDestination(destination), mSource(source) {}
+
+  KOKKOS_FUNCTION void operator()(std::int64_t const i,
+                                  std::int64_t const j) const {
+    mDestination(i, j) = mSource(i, j);
+  }
+
+  KOKKOS_FUNCTION void operator()(std::int64_t const i, std::int64_t const j,
+                                  std::int64_t const k) const {
+    mDestination(i, j, k) = mSource(i, j, k);
+  }
+};
+
+/**
+ * Copy a View into another one of the same memory space and of a different
+ * layout, with a parallel tiled transpose.
+ *
+ * Tiles keep the elements read and written by a team or a thread close in
+ * both layouts. Views of rank higher than 3 are copied with
+ * `Kokkos::deep_copy`.
+ *
+ * @tparam ExecutionSpace Kokkos execution space of the copy.
+ * @tparam isForDevice If `true`, use tiles suited for the device, otherwise
+ * for the host.
+ * @tparam Destination Type of the destination View.
+ * @tparam Source Type of the source View.
+ * @param space Instance of the execution space.
+ * @param destination Destination View.
+ * @param source Source View.
+ */
+template <typename ExecutionSpace, bool isForDevice, typename Destination,
+          typename Source>
+void transpose(ExecutionSpace const &space, Destination const &destination,
+               Source const &source) {
+  constexpr std::size_t rank = Destination::rank;
+
+  if constexpr (rank == 2 || rank == 3) {
+    using Policy =
+        Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<rank>,
+                              Kokkos::IndexType<std::int64_t>>;
+    using Point = typename Policy::point_type;
+
+    Point begin;
+    Point end;
+    Point tile;
+    for (std::size_t dimension = 0; dimension < rank; dimension++) {
+      begin[dimension] = 0;
+      end[dimension] = destination.extent(dimension);
+    }
+    if constexpr (rank == 2) {
+      tile[0] = isForDevice ? 16 : 32;
+      tile[1] = isForDevice ? 16 : 32;
+    } else {
+      tile[0] = isForDevice ? 8 : 16;
+      tile[1] = isForDevice ? 8 : 16;
+      tile[2] = isForDevice ? 4 : 16;
+    }
+
+    Kokkos::parallel_for("dynk transpose", Policy(space, begin, end, tile),
+                         TransposeFunctor<Destination, Source>(destination,
+                                                               source));
+  } else {
+    Kokkos::deep_copy(space, destination, source);
+  }
+}
+
+} // namespace impl
+
+/**
+ * Dual container with a layout for the device side and a layout for the
+ * host side.
+ *
+ * Copies of the container share the same data and the same modification
+ * state, as for a DualView. If both sides use the same memory space, a single
+ * View with the host layout is shared by both sides.
+ *
+ * @tparam DataType Data type of the Views.
+ * @tparam DeviceLayout Layout of the device View, defaults to
+ * `Kokkos::LayoutLeft`.
+ * @tparam HostLayout Layout of the host View, defaults to
+ * `Kokkos::LayoutRight`.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ */
+template <typename DataType, typename DeviceLayout = Kokkos::LayoutLeft,
+          typename HostLayout = Kokkos::LayoutRight,
+          typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace>
+class LayoutDualView {
+  using DeviceMemorySpace = typename DeviceExecutionSpace::memory_space;
+  using HostMemorySpace = typename HostExecutionSpace::memory_space;
+
+public:
+  static constexpr bool isSingleSpace =
+      std::is_same_v<DeviceMemorySpace, HostMemorySpace>;
+
+  using t_host = Kokkos::View<DataType, HostLayout,
+                              Kokkos::Device<HostExecutionSpace,
+                                             HostMemorySpace>>;
+  using t_dev = std::conditional_t<
+      isSingleSpace, t_host,
+      Kokkos::View<DataType, DeviceLayout,
+                   Kokkos::Device<DeviceExecutionSpace, DeviceMemorySpace>>>;
+  using host_mirror_space = HostMemorySpace;
+  using memory_space = DeviceMemorySpace;
+
+  t_dev d_view;
+  t_host h_view;
+
+private:
+  using Staging =
+      Kokkos::View<DataType, HostLayout,
+                   Kokkos::Device<DeviceExecutionSpace, DeviceMemorySpace>>;
+
+  /**
+   * State shared by the copies of the container.
+   */
+  struct State {
+    /// Modification counters of the host side and of the device side.
+    std::size_t modified[2] = {0, 0};
+    /// Device buffer with the host layout, allocated on first transfer.
+    Staging staging;
+  };
+
+  std::shared_ptr<State> mState;
+
+  template <typename Space> static constexpr bool isHostSide() {
+    return std::is_same_v<typename Space::memory_space, HostMemorySpace>;
+  }
+
+  Staging &getStaging() {
+    if (!mState->staging.is_allocated()) {
+      mState->staging = Staging(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             h_view.label() + " staging"),
+          h_view.layout());
+    }
+    return mState->staging;
+  }
+
+public:
+  LayoutDualView() = default;
+
+  /**
+   * Allocate the host View and the device View.
+   *
+   * @tparam Extents Type of the extents.
+   * @param label Label of both Views.
+   * @param extents Extents of both Views.
+   */
+  template <typename... Extents>
+  explicit LayoutDualView(std::string const &label, Extents const... extents)
+      : h_view(label, extents...), mState(std::make_shared<State>()) {
+    if constexpr (isSingleSpace) {
+      d_view = h_view;
+    } else {
+      d_view = t_dev(label, extents...);
+    }
+  }
+
+  t_host const &view_host() const { return h_view; }
+
+  t_dev const &view_device() const { return d_view; }
+
+  /**
+   * Get the View of a side.
+   *
+   * @tparam Space Memory space or execution space of the side.
+   * @return View with the layout of the side.
+   */
+  template <typename Space> auto const &view() const {
+    if constexpr (isHostSide<Space>()) {
+      return h_view;
+    } else {
+      return d_view;
+    }
+  }
+
+  std::size_t extent(std::size_t const dimension) const {
+    return h_view.extent(dimension);
+  }
+
+  bool need_sync_host() const {
+    return mState && mState->modified[1] > mState->modified[0];
+  }
+
+  bool need_sync_device() const {
+    return mState && mState->modified[0] > mState->modified[1];
+  }
+
+  void modify_host() {
+    if (mState) {
+      mState->modified[0] =
+          std::max(mState->modified[0], mState->modified[1]) + 1;
+    }
+  }
+
+  void modify_device() {
+    if (mState) {
+      mState->modified[1] =
+          std::max(mState->modified[0], mState->modified[1]) + 1;
+    }
+  }
+
+  void clear_sync_state() {
+    if (mState) {
+      mState->modified[0] = mState->modified[1] = 0;
+    }
+  }
+
+  /**
+   * Update the host View from the device View if needed.
+   *
+   * The device View is transposed into the staging buffer on the device,
+   * which is then copied contiguously to the host.
+   */
+  void sync_host() { sync_host(DeviceExecutionSpace()); }
+
+  /**
+   * Update the host View from the device View if needed, on an instance of
+   * the device execution space.
+   *
+   * @param space Instance to transpose and copy on.
+   */
+  void sync_host(DeviceExecutionSpace const &space) {
+    if (!need_sync_host()) {
+      return;
+    }
+
+    if constexpr (!isSingleSpace) {
+      auto &staging = getStaging();
+      impl::transpose<DeviceExecutionSpace, true>(space, staging, d_view);
+      Kokkos::deep_copy(space, h_view, staging);
+      space.fence("end of dynk layout dual view sync to host");
+    }
+
+    mState->modified[0] = mState->modified[1];
+  }
+
+  /**
+   * Update the device View from the host View if needed.
+   *
+   * The host View is copied contiguously to the staging buffer on the
+   * device, which is then transposed into the device View.
+   */
+  void sync_device() { sync_device(DeviceExecutionSpace()); }
+
+  /**
+   * Update the device View from the host View if needed, on an instance of
+   * the device execution space.
+   *
+   * @param space Instance to copy and transpose on.
+   */
+  void sync_device(DeviceExecutionSpace const &space) {
+    if (!need_sync_device()) {
+      return;
+    }
+
+    if constexpr (!isSingleSpace) {
+      auto &staging = getStaging();
+      Kokkos::deep_copy(space, staging, h_view);
+      impl::transpose<DeviceExecutionSpace, true>(space, d_view, staging);
+      space.fence("end of dynk layout dual view sync to device");
+    }
+
+    mState->modified[1] = mState->modified[0];
+  }
+
+  /**
+   * Update the View of a side if needed.
+   *
+   * @tparam Space Memory space or execution space of the side.
+   */
+  template <typename Space> void sync() {
+    if constexpr (isHostSide<Space>()) {
+      sync_host();
+    } else {
+      sync_device();
+    }
+  }
+
+  /**
+   * Mark the View of a side as modified.
+   *
+   * @tparam Space Memory space or execution space of the side.
+   */
+  template <typename Space> void modify() {
+    if constexpr (isHostSide<Space>()) {
+      modify_host();
+    } else {
+      modify_device();
+    }
+  }
+};
+
+/**
+ * Get a View of a LayoutDualView dynamically.
+ *
+ * As the layout differs between sides, the View is strided.
+ *
+ * @tparam DeviceMemorySpace Unused, for compatibility with DualView helpers.
+ * @tparam HostMemorySpace Unused, for compatibility with DualView helpers.
+ * @tparam DataType Data type of the LayoutDualView.
+ * @tparam P Parameters of the LayoutDualView.
+ * @param dualView LayoutDualView to take a view from.
+ * @param isExecutedOnDevice If `true`, returns the device view, otherwise,
+ * returns the host view.
+ * @return Strided View in the requested memory space.
+ */
+template <
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space,
+    typename DataType, typename... P>
+Kokkos::View<DataType, Kokkos::LayoutStride, Kokkos::AnonymousSpace>
+getView(LayoutDualView<DataType, P...> &dualView,
+        bool const isExecutedOnDevice) {
+  if (isExecutedOnDevice) {
+    return dualView.d_view;
+  } else {
+    return dualView.h_view;
+  }
+}
+
+/**
+ * Get a View of a constant LayoutDualView dynamically.
+ *
+ * As the layout differs between sides, the View is strided.
+ *
+ * @tparam DeviceMemorySpace Unused, for compatibility with DualView helpers.
+ * @tparam HostMemorySpace Unused, for compatibility with DualView helpers.
+ * @tparam DataType Data type of the LayoutDualView.
+ * @tparam P Parameters of the LayoutDualView.
+ * @param dualView LayoutDualView to take a view from.
+ * @param isExecutedOnDevice If `true`, returns the device view, otherwise,
+ * returns the host view.
+ * @return Strided View in the requested memory space.
+ */
+template <
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space,
+    typename DataType, typename... P>
+Kokkos::View<DataType, Kokkos::LayoutStride, Kokkos::AnonymousSpace>
+getView(LayoutDualView<DataType, P...> const &dualView,
+        bool const isExecutedOnDevice) {
+  if (isExecutedOnDevice) {
+    return dualView.d_view;
+  } else {
+    return dualView.h_view;
+  }
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_LAYOUT_DUAL_VIEW_HPP__
@@ -0,0 +1,144 @@
+#ifndef __DYNK_MAPPED_FILE_HPP__
+#define __DYNK_MAPPED_FILE_HPP__
+
+/**
+ * Memory-mapped file.
+ *
+ * A binary file of values can be mapped in memory with POSIX `mmap` and
+ * accessed through an unmanaged host View, for instance as the source or the
+ * destination of `dynk::parallel_for_stream`. Pages are read from the file
+ * when first accessed, so the file does not have to fit in the host memory.
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Kokkos_Core.hpp>
+
+namespace dynk {
+
+/**
+ * File of values mapped in host memory.
+ *
+ * The mapping is released on destruction. Errors are reported with a
+ * `std::runtime_error`.
+ *
+ * @tparam Value Type of the values of the file.
+ */
+template <typename Value> class MappedFile {
+public:
+  using View = Kokkos::View<Value *, Kokkos::HostSpace,
+                            Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+private:
+  Value *mData = nullptr;
+  std::size_t mCount = 0;
+
+  [[noreturn]] static void fail(std::string const &message,
+                                std::string const &path) {
+    throw std::runtime_error(message + " " + path + ": " +
+                             std::strerror(errno));
+  }
+
+  void map(int const descriptor, std::string const &path, int const protection,
+           int const flags) {
+    if (mCount > 0) {
+      void *const data = mmap(nullptr, mCount * sizeof(Value), protection,
+                              flags, descriptor, 0);
+      if (data == MAP_FAILED) {
+        close(descriptor);
+        fail("Cannot map", path);
+      }
+      // hint the kernel that the file is read in order
+      madvise(data, mCount * sizeof(Value), MADV_SEQUENTIAL);
+      mData = static_cast<Value *>(data);
+    }
+
+    // the mapping remains valid once the file is closed
+    close(descriptor);
+  }
+
+public:
+  /**
+   * Map an existing file for reading.
+   *
+   * The mapping is private: values can be modified, but modifications are
+   * not written to the file.
+   *
+   * @param path Path of the file.
+   */
+  explicit MappedFile(std::string const &path) {
+    int const descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      fail("Cannot open", path);
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      close(descriptor);
+      fail("Cannot get the size of", path);
+    }
+    mCount = static_cast<std::size_t>(status.st_size) / sizeof(Value);
+
+    map(descriptor, path, PROT_READ | PROT_WRITE, MAP_PRIVATE);
+  }
+
+  /**
+   * Map a file for reading and writing, creating it or resizing it to a
+   * number of values.
+   *
+   * Modifications are written to the file.
+   *
+   * @param path Path of the file.
+   * @param count Number of values.
+   */
+  MappedFile(std::string const &path, std::size_t const count)
+      : mCount(count) {
+    int const descriptor = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descriptor < 0) {
+      fail("Cannot open", path);
+    }
+
+    if (ftruncate(descriptor, static_cast<off_t>(count * sizeof(Value))) !=
+        0) {
+      close(descriptor);
+      fail("Cannot resize", path);
+    }
+
+    map(descriptor, path, PROT_READ | PROT_WRITE, MAP_SHARED);
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile() {
+    if (mData != nullptr) {
+      munmap(mData, mCount * sizeof(Value));
+    }
+  }
+
+  /**
+   * Get the number of values.
+   */
+  std::size_t getCount() const { return mCount; }
+
+  /**
+   * Get an unmanaged host View of the values, valid as long as the file is
+   * mapped.
+   *
+   * @return View.
+   */
+  View getView() const { return View(mData, mCount); }
+};
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_MAPPED_FILE_HPP__
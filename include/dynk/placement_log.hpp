@@ -0,0 +1,473 @@
+#ifndef __DYNK_PLACEMENT_LOG_HPP__
+#define __DYNK_PLACEMENT_LOG_HPP__
+
+/**
+ * Record and replay of placement decisions.
+ *
+ * When the macro `DYNK_ENABLE_PLACEMENT_LOG` is defined (with the CMake option
+ * of the same name), the labeled dynamic constructs record each dispatch in
+ * the placement log once `dynk::startPlacementRecording` is called: its
+ * label, its index among the calls with this label, its side and its
+ * duration. `dynk::async_for` and `dynk::TaskGraph::run` do not fence, so
+ * only the launch of their kernels is timed. `dynk::wrap`, which takes no
+ * label, is not recorded. The log is written to a compact binary file when
+ * `dynk::stopPlacementLog` is called, or when Kokkos is finalized.
+ *
+ * A recorded log can be replayed in a later run with
+ * `dynk::startPlacementReplay`. As the side of a kernel must be known before
+ * its data are synchronized, replay goes through `dynk::place`, which returns
+ * the recorded side of the next call with a label:
+ *
+ * ```cpp
+ * bool const isExecutedOnDevice = dynk::place("step", heuristic());
+ * auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+ * dynk::parallel_for(isExecutedOnDevice, "step", n, kernel);
+ * ```
+ *
+ * Two logs can be compared per label with `dynk::diffPlacementLogs`, or with
+ * the `placement-diff` tool.
+ *
+ * The file starts with a magic string and a version, followed by the table
+ * of labels and by the records. Values are stored in the native byte order.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+namespace dynk {
+
+/**
+ * Placement decision of a dispatch.
+ */
+struct PlacementRecord {
+  /// Label of the kernel.
+  std::string label;
+  /// Index of the call among the calls with the same label.
+  std::uint32_t callIndex = 0;
+  /// Side of the kernel.
+  bool isExecutedOnDevice = false;
+  /// Duration of the dispatch in seconds, fences included.
+  double time = 0.;
+};
+
+/**
+ * Comparison of the dispatches of a label in two placement logs.
+ */
+struct PlacementDifference {
+  /// Number of calls in the first and in the second log.
+  std::size_t callsCount[2] = {0, 0};
+  /// Number of calls on device in the first and in the second log.
+  std::size_t deviceCallsCount[2] = {0, 0};
+  /// Number of calls present in both logs and placed on different sides.
+  std::size_t sideChangesCount = 0;
+  /// Total duration in seconds in the first and in the second log.
+  double time[2] = {0., 0.};
+};
+
+namespace impl {
+
+/**
+ * Magic string starting a placement log file.
+ */
+constexpr char placementLogMagic[8] = {'D', 'Y', 'N', 'K', 'P', 'L', 'O', 'G'};
+
+/**
+ * Version of the placement log file format.
+ */
+constexpr std::uint32_t placementLogVersion = 1;
+
+/**
+ * Write a value to a binary stream in the native byte order.
+ *
+ * @tparam Value Type of the value.
+ * @param stream Output stream.
+ * @param value Value to write.
+ */
+template <typename Value>
+void writeValue(std::ostream &stream, Value const &value) {
+  stream.write(reinterpret_cast<char const *>(&value), sizeof(Value));
+}
+
+/**
+ * Read a value from a binary stream in the native byte order.
+ *
+ * @tparam Value Type of the value.
+ * @param stream Input stream.
+ * @return Value read.
+ */
+template <typename Value> Value readValue(std::istream &stream) {
+  Value value;
+  stream.read(reinterpret_cast<char *>(&value), sizeof(Value));
+  if (!stream) {
+    throw std::runtime_error("Truncated placement log");
+  }
+  return value;
+}
+
+/**
+ * Read a size from a binary stream, and check that the remaining data can
+ * hold that many elements, so that nothing is allocated for a corrupted size.
+ *
+ * @tparam Size Type of the size.
+ * @param stream Input stream.
+ * @param elementBytes Minimal number of bytes of an element.
+ * @return Size read.
+ */
+template <typename Size>
+std::size_t readSize(std::istream &stream, std::size_t const elementBytes) {
+  auto const size = readValue<Size>(stream);
+  auto const position = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  auto const remainingBytes =
+      static_cast<std::uint64_t>(stream.tellg() - position);
+  stream.seekg(position);
+  if (size > remainingBytes / elementBytes) {
+    throw std::runtime_error("Truncated placement log");
+  }
+  return static_cast<std::size_t>(size);
+}
+
+} // namespace impl
+
+/**
+ * Write placement records to a binary file.
+ *
+ * @param path Path of the file.
+ * @param records Records to write.
+ */
+inline void writePlacementLog(std::string const &path,
+                              std::vector<PlacementRecord> const &records) {
+  std::ofstream stream(path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("Cannot open placement log " + path);
+  }
+
+  // labels are stored once
+  std::map<std::string, std::uint32_t> labelIndices;
+  std::vector<std::string const *> labels;
+  for (auto const &record : records) {
+    if (labelIndices.try_emplace(record.label, labels.size()).second) {
+      labels.push_back(&record.label);
+    }
+  }
+
+  stream.write(impl::placementLogMagic, sizeof(impl::placementLogMagic));
+  impl::writeValue(stream, impl::placementLogVersion);
+  impl::writeValue(stream, static_cast<std::uint32_t>(labels.size()));
+  for (auto const *label : labels) {
+    impl::writeValue(stream, static_cast<std::uint32_t>(label->size()));
+    stream.write(label->data(), label->size());
+  }
+
+  impl::writeValue(stream, static_cast<std::uint64_t>(records.size()));
+  for (auto const &record : records) {
+    impl::writeValue(stream, labelIndices[record.label]);
+    impl::writeValue(stream, record.callIndex);
+    impl::writeValue(stream,
+                     static_cast<std::uint8_t>(record.isExecutedOnDevice));
+    impl::writeValue(stream, record.time);
+  }
+
+  if (!stream) {
+    throw std::runtime_error("Cannot write placement log " + path);
+  }
+}
+
+/**
+ * Read placement records from a binary file.
+ *
+ * @param path Path of the file.
+ * @return Records.
+ */
+inline std::vector<PlacementRecord>
+readPlacementLog(std::string const &path) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("Cannot open placement log " + path);
+  }
+
+  char magic[sizeof(impl::placementLogMagic)] = {};
+  stream.read(magic, sizeof(magic));
+  if (!stream ||
+      !std::equal(magic, magic + sizeof(magic), impl::placementLogMagic) ||
+      impl::readValue<std::uint32_t>(stream) != impl::placementLogVersion) {
+    throw std::runtime_error("Invalid placement log " + path);
+  }
+
+  // each label has at least its size, each record its fields
+  std::vector<std::string> labels(
+      impl::readSize<std::uint32_t>(stream, sizeof(std::uint32_t)));
+  for (auto &label : labels) {
+    label.resize(impl::readSize<std::uint32_t>(stream, 1));
+    stream.read(label.data(), label.size());
+  }
+
+  std::vector<PlacementRecord> records(impl::readSize<std::uint64_t>(
+      stream, 2 * sizeof(std::uint32_t) + sizeof(std::uint8_t) +
+                  sizeof(double)));
+  for (auto &record : records) {
+    auto const labelIndex = impl::readValue<std::uint32_t>(stream);
+    if (labelIndex >= labels.size()) {
+      throw std::runtime_error("Invalid placement log " + path);
+    }
+    record.label = labels[labelIndex];
+    record.callIndex = impl::readValue<std::uint32_t>(stream);
+    record.isExecutedOnDevice = impl::readValue<std::uint8_t>(stream) != 0;
+    record.time = impl::readValue<double>(stream);
+  }
+
+  return records;
+}
+
+/**
+ * Compare two sets of placement records per label.
+ *
+ * @param first First records.
+ * @param second Second records.
+ * @return Map of comparisons, indexed by label.
+ */
+inline std::map<std::string, PlacementDifference>
+diffPlacementLogs(std::vector<PlacementRecord> const &first,
+                  std::vector<PlacementRecord> const &second) {
+  std::map<std::string, PlacementDifference> differences;
+  std::map<std::pair<std::string, std::uint32_t>, bool> firstSides;
+
+  for (auto const &record : first) {
+    auto &difference = differences[record.label];
+    difference.callsCount[0]++;
+    difference.deviceCallsCount[0] += record.isExecutedOnDevice;
+    difference.time[0] += record.time;
+    firstSides[{record.label, record.callIndex}] = record.isExecutedOnDevice;
+  }
+
+  for (auto const &record : second) {
+    auto &difference = differences[record.label];
+    difference.callsCount[1]++;
+    difference.deviceCallsCount[1] += record.isExecutedOnDevice;
+    difference.time[1] += record.time;
+    auto const firstSide = firstSides.find({record.label, record.callIndex});
+    if (firstSide != firstSides.end() &&
+        firstSide->second != record.isExecutedOnDevice) {
+      difference.sideChangesCount++;
+    }
+  }
+
+  return differences;
+}
+
+namespace impl {
+
+/**
+ * Registry of the recorded and replayed placement decisions.
+ */
+class PlacementLog {
+  mutable std::mutex mMutex;
+  bool mIsRecording = false;
+  std::string mRecordingPath;
+  std::map<std::string, std::uint32_t, std::less<>> mCallsCounts;
+  std::vector<PlacementRecord> mRecords;
+  bool mIsReplaying = false;
+  std::map<std::string, std::vector<bool>, std::less<>> mReplayedSides;
+  std::map<std::string, std::uint32_t, std::less<>> mPlacesCounts;
+
+  void writeRecording() {
+    if (mIsRecording) {
+      writePlacementLog(mRecordingPath, mRecords);
+    }
+    mIsRecording = false;
+    mRecords.clear();
+    mCallsCounts.clear();
+  }
+
+public:
+  /**
+   * Get the unique instance of the registry.
+   *
+   * On first call, a hook is registered to write the recording when Kokkos is
+   * finalized.
+   */
+  static PlacementLog &get() {
+    static PlacementLog instance;
+    static bool const isHookRegistered = [] {
+      Kokkos::push_finalize_hook([] {
+        // exceptions must not escape the finalization
+        try {
+          PlacementLog::get().stop();
+        } catch (std::exception const &error) {
+          std::cerr << "Dynk placement log: " << error.what() << "\n";
+        }
+      });
+      return true;
+    }();
+    static_cast<void>(isHookRegistered);
+    return instance;
+  }
+
+  void startRecording(std::string const &path) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    writeRecording();
+    mIsRecording = true;
+    mRecordingPath = path;
+  }
+
+  void startReplay(std::string const &path) {
+    auto const records = readPlacementLog(path);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsReplaying = true;
+    mReplayedSides.clear();
+    mPlacesCounts.clear();
+    for (auto const &record : records) {
+      auto &sides = mReplayedSides[record.label];
+      if (sides.size() <= record.callIndex) {
+        sides.resize(record.callIndex + 1);
+      }
+      sides[record.callIndex] = record.isExecutedOnDevice;
+    }
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    writeRecording();
+    mIsReplaying = false;
+    mReplayedSides.clear();
+    mPlacesCounts.clear();
+  }
+
+  /**
+   * Record a dispatch.
+   *
+   * @param label Label of the kernel.
+   * @param isExecutedOnDevice Side of the kernel.
+   * @param time Duration of the dispatch in seconds.
+   */
+  void onDispatch(std::string const &label, bool const isExecutedOnDevice,
+                  double const time) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mIsRecording) {
+      return;
+    }
+    auto callsCount = mCallsCounts.find(label);
+    if (callsCount == mCallsCounts.end()) {
+      callsCount = mCallsCounts.emplace(label, 0).first;
+    }
+    mRecords.push_back({label, callsCount->second++, isExecutedOnDevice, time});
+  }
+
+  /**
+   * Get the side of the next call with a label.
+   *
+   * @param label Label of the kernel.
+   * @param isExecutedOnDevice Side proposed.
+   * @return Replayed side if any, proposed side otherwise.
+   */
+  bool place(std::string const &label, bool const isExecutedOnDevice) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mIsReplaying) {
+      return isExecutedOnDevice;
+    }
+    auto const sides = mReplayedSides.find(label);
+    if (sides == mReplayedSides.end()) {
+      return isExecutedOnDevice;
+    }
+    auto const callIndex = mPlacesCounts[label]++;
+    return callIndex < sides->second.size() ? sides->second[callIndex]
+                                            : isExecutedOnDevice;
+  }
+};
+
+/**
+ * Get the time at which a dispatch starts, if placement logging is enabled.
+ *
+ * @return Time in seconds.
+ */
+inline double getPlacementTime() {
+#ifdef DYNK_ENABLE_PLACEMENT_LOG
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#else
+  return 0.;
+#endif // ifdef DYNK_ENABLE_PLACEMENT_LOG
+}
+
+/**
+ * Record a dispatch in the placement log, if placement logging is enabled.
+ *
+ * @param label Label of the kernel.
+ * @param isExecutedOnDevice Side of the kernel.
+ * @param start Time at which the dispatch started, from `getPlacementTime`.
+ */
+inline void recordPlacement([[maybe_unused]] std::string const &label,
+                            [[maybe_unused]] bool const isExecutedOnDevice,
+                            [[maybe_unused]] double const start) {
+#ifdef DYNK_ENABLE_PLACEMENT_LOG
+  PlacementLog::get().onDispatch(label, isExecutedOnDevice,
+                                 getPlacementTime() - start);
+#endif // ifdef DYNK_ENABLE_PLACEMENT_LOG
+}
+
+} // namespace impl
+
+/**
+ * Start recording the dispatches in the placement log.
+ *
+ * A recording in progress is written first. Dispatches are only recorded if
+ * `DYNK_ENABLE_PLACEMENT_LOG` is defined.
+ *
+ * @param path Path of the file to write the log to.
+ */
+inline void startPlacementRecording(std::string const &path) {
+  impl::PlacementLog::get().startRecording(path);
+}
+
+/**
+ * Start replaying the placement decisions of a log with `dynk::place`.
+ *
+ * @param path Path of the file to read the log from.
+ */
+inline void startPlacementReplay(std::string const &path) {
+  impl::PlacementLog::get().startReplay(path);
+}
+
+/**
+ * Write the recording in progress, if any, and stop recording and replaying.
+ *
+ * This is automatically done when Kokkos is finalized.
+ */
+inline void stopPlacementLog() { impl::PlacementLog::get().stop(); }
+
+/**
+ * Get the side of the next call with a label.
+ *
+ * When a log is replayed, the side recorded for the call with the same label
+ * and the same index is returned. Otherwise, or if the log has no such call,
+ * the proposed side is returned. This function should be called once per
+ * dispatch of the label.
+ *
+ * @param label Label of the kernel.
+ * @param isExecutedOnDevice Side proposed.
+ * @return Side to execute the kernel on.
+ */
+inline bool place(std::string const &label, bool const isExecutedOnDevice) {
+  return impl::PlacementLog::get().place(label, isExecutedOnDevice);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_PLACEMENT_LOG_HPP__
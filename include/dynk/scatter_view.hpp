@@ -0,0 +1,231 @@
+#ifndef __DYNK_SCATTER_VIEW_HPP__
+#define __DYNK_SCATTER_VIEW_HPP__
+
+/**
+ * Scatter contributions.
+ *
+ * This approach proposes a parallel construct for kernels that scatter
+ * contributions into an array (e.g. histograms or scatter-add), which is
+ * executed dynamically on device or on host like `dynk::parallel_for`. The
+ * contributions are made through a `Kokkos::Experimental::ScatterView`, whose
+ * duplication and contribution strategies are chosen at runtime for the
+ * chosen side, then added to a DualView which is marked as modified.
+ */
+
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/placement_log.hpp"
+
+namespace dynk {
+
+/**
+ * Strategy used to scatter contributions.
+ */
+enum class ScatterStrategy {
+  /// Atomic contributions on the device, duplicated arrays on a multithreaded
+  /// host, plain contributions on a single-threaded host.
+  Automatic,
+  /// One duplicate of the array per thread, reduced at the end.
+  Duplicated,
+  /// Atomic contributions to a single array, plain contributions if the
+  /// execution space is single-threaded.
+  Atomic,
+};
+
+namespace impl {
+
+/**
+ * Functor giving a scatter access to a kernel.
+ *
+ * @tparam ScatterView Type of the ScatterView.
+ * @tparam Kernel Type of the kernel.
+ */
+template <typename ScatterView, typename Kernel> struct ScatterFunctor {
+  ScatterView mScatterView;
+  Kernel mKernel;
+
+  ScatterFunctor(ScatterView const &scatterView, Kernel const &kernel)
+      : mScatterView(scatterView), mKernel(kernel) {}
+
+  template <typename... Indices>
+  KOKKOS_FUNCTION void operator()(Indices const... indices) const {
+    auto access = mScatterView.access();
+    mKernel(indices..., access);
+  }
+};
+
+/**
+ * Scatter contributions into a DualView with given ScatterView strategies.
+ *
+ * @tparam Operation ScatterView operation.
+ * @tparam Duplication ScatterView duplication strategy.
+ * @tparam Contribution ScatterView contribution strategy.
+ * @tparam ExecutionSpace Execution space of the kernel.
+ * @tparam MemorySpace Memory space of the DualView to contribute to.
+ * @tparam isForDevice If `true`, use the device parameters of the Dynk
+ * execution policy, otherwise the host ones.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @tparam DualView Type of the DualView.
+ * @tparam Kernel Type of the kernel.
+ * @param label Label of the kernel.
+ * @param executionPolicy Dynk execution policy.
+ * @param dualView DualView to contribute to.
+ * @param kernel Kernel.
+ */
+template <typename Operation, typename Duplication, typename Contribution,
+          typename ExecutionSpace, typename MemorySpace, bool isForDevice,
+          typename ExecutionPolicy, typename DualView, typename Kernel>
+void scatterWith(std::string const &label,
+                 ExecutionPolicy const &executionPolicy, DualView &dualView,
+                 Kernel const &kernel) {
+  auto view = getSyncedView<MemorySpace>(dualView);
+  using View = decltype(view);
+  using ScatterView = Kokkos::Experimental::ScatterView<
+      typename View::data_type, typename View::array_layout,
+      Kokkos::Device<ExecutionSpace, MemorySpace>, Operation, Duplication,
+      Contribution>;
+
+  auto const space = getSpace<ExecutionSpace>();
+  ScatterView scatterView(space, view);
+  launch<ExecutionSpace, isForDevice>(
+      label, space, executionPolicy, [&](auto const &policy) {
+        Kokkos::parallel_for(label, policy,
+                             ScatterFunctor<ScatterView, Kernel>(scatterView,
+                                                                 kernel));
+      });
+  Kokkos::Experimental::contribute(space, view, scatterView);
+
+  setModified<MemorySpace>(dualView);
+}
+
+/**
+ * Scatter contributions into a DualView with a runtime strategy.
+ *
+ * @tparam Operation ScatterView operation.
+ * @tparam ExecutionSpace Execution space of the kernel.
+ * @tparam MemorySpace Memory space of the DualView to contribute to.
+ * @tparam isForDevice If `true`, the contributions are made on the device
+ * side, otherwise on the host side.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @tparam DualView Type of the DualView.
+ * @tparam Kernel Type of the kernel.
+ * @param strategy Strategy.
+ * @param label Label of the kernel.
+ * @param executionPolicy Dynk execution policy.
+ * @param dualView DualView to contribute to.
+ * @param kernel Kernel.
+ */
+template <typename Operation, typename ExecutionSpace, typename MemorySpace,
+          bool isForDevice, typename ExecutionPolicy, typename DualView,
+          typename Kernel>
+void scatter(ScatterStrategy strategy, std::string const &label,
+             ExecutionPolicy const &executionPolicy, DualView &dualView,
+             Kernel const &kernel) {
+  namespace KE = Kokkos::Experimental;
+
+  bool const isConcurrent = ExecutionSpace().concurrency() > 1;
+
+  if (strategy == ScatterStrategy::Automatic) {
+    strategy = isForDevice || !isConcurrent ? ScatterStrategy::Atomic
+                                            : ScatterStrategy::Duplicated;
+  }
+
+  if (strategy == ScatterStrategy::Duplicated) {
+    scatterWith<Operation, KE::ScatterDuplicated, KE::ScatterNonAtomic,
+                ExecutionSpace, MemorySpace, isForDevice>(
+        label, executionPolicy, dualView, kernel);
+  } else if (isConcurrent) {
+    scatterWith<Operation, KE::ScatterNonDuplicated, KE::ScatterAtomic,
+                ExecutionSpace, MemorySpace, isForDevice>(
+        label, executionPolicy, dualView, kernel);
+  } else {
+    scatterWith<Operation, KE::ScatterNonDuplicated, KE::ScatterNonAtomic,
+                ExecutionSpace, MemorySpace, isForDevice>(
+        label, executionPolicy, dualView, kernel);
+  }
+}
+
+} // namespace impl
+
+/**
+ * Parallel for scattering contributions into a DualView, that can be
+ * executed dynamically on device or on host depending on a Boolean
+ * parameter.
+ *
+ * The kernel receives the indices of the iteration, then a scatter access to
+ * contribute to (e.g. `access(bin) += 1`), and should hence be generic for
+ * its last argument:
+ *
+ * ```cpp
+ * dynk::parallel_scatter(
+ *     isExecutedOnDevice, "histogram", dynk::RangePolicy(0, n), binsDV,
+ *     KOKKOS_LAMBDA(int const i, auto &access) { access(binV(i)) += 1; });
+ * ```
+ *
+ * The DualView is synchronized on the chosen side, contributions are added to
+ * its values, and it is marked as modified on the chosen side.
+ *
+ * @tparam Operation ScatterView operation, defaults to
+ * `Kokkos::Experimental::ScatterSum`.
+ * @tparam ExecutionPolicy Type of the Dynk execution policy.
+ * @tparam DualView Type of the DualView.
+ * @tparam Kernel Type of the kernel.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param executionPolicy Object containing the parameters to create a Kokkos
+ * execution policy.
+ * @param dualView DualView to contribute to.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ * @param strategy Strategy to scatter contributions, defaults to an automatic
+ * choice for the chosen side.
+ */
+template <
+    typename Operation = Kokkos::Experimental::ScatterSum,
+    typename ExecutionPolicy, typename DualView, typename Kernel,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+void parallel_scatter(
+    bool const isExecutedOnDevice, std::string const &label,
+    ExecutionPolicy const &executionPolicy, DualView &dualView,
+    Kernel const &kernel,
+    ScatterStrategy const strategy = ScatterStrategy::Automatic) {
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic parallel scatter"));
+  double const start = impl::getPlacementTime();
+
+  if (isExecutedOnDevice) {
+    // device execution
+    impl::scatter<Operation, DeviceExecutionSpace, DeviceMemorySpace, true>(
+        strategy, label, executionPolicy, dualView, kernel);
+  } else {
+    // host execution
+    impl::scatter<Operation, HostExecutionSpace, HostMemorySpace, false>(
+        strategy, label, executionPolicy, dualView, kernel);
+  }
+
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic parallel scatter"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_SCATTER_VIEW_HPP__
@@ -0,0 +1,242 @@
+#ifndef __DYNK_SIMD_HPP__
+#define __DYNK_SIMD_HPP__
+
+/**
+ * Explicit SIMD.
+ *
+ * This approach proposes a parallel construct executing a single generic
+ * kernel body with `Kokkos::Experimental::native_simd` packs over contiguous
+ * chunks on the host, and with scalars on the device, where vectorization
+ * comes from threads. The kernel receives a `dynk::SimdIndex`, and reads and
+ * writes Views with `dynk::simdLoad` and `dynk::simdStore`:
+ *
+ * ```cpp
+ * dynk::simd_for<double>(
+ *     isExecutedOnDevice, "triad", n, KOKKOS_LAMBDA(auto const index) {
+ *       auto const b = dynk::simdLoad(bV, index);
+ *       auto const c = dynk::simdLoad(cV, index);
+ *       dynk::simdStore(b + 3. * c, aV, index);
+ *     });
+ * ```
+ */
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_SIMD.hpp>
+
+#include "dynk/label.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Get the number of elements of a pack.
+ *
+ * @tparam Pack Type of the pack, either a scalar or a SIMD type.
+ * @return Number of elements.
+ */
+template <typename Pack> constexpr std::size_t getPackWidth() {
+  if constexpr (std::is_arithmetic_v<Pack>) {
+    return 1;
+  } else {
+    return Pack::size();
+  }
+}
+
+} // namespace impl
+
+/**
+ * Index of a pack of contiguous elements processed by a kernel of
+ * `dynk::simd_for`.
+ *
+ * @tparam Pack Type of the pack, a `Kokkos::Experimental::native_simd` on
+ * host, or a scalar on device and for the remainder on host.
+ */
+template <typename Pack> struct SimdIndex {
+  using value_type = Pack;
+
+  /// Number of elements of the pack.
+  static constexpr std::size_t width = impl::getPackWidth<Pack>();
+
+  /// Index of the first element of the pack.
+  std::size_t first;
+};
+
+namespace impl {
+
+/**
+ * Tell if the elements of a rank 1 View are contiguous.
+ *
+ * @tparam View Type of the View.
+ * @param view View to check.
+ * @return `true` if the elements can be read and written by packs directly.
+ */
+template <typename View>
+KOKKOS_FUNCTION bool isContiguous(View const &view) {
+  if constexpr (std::is_same_v<typename View::array_layout,
+                               Kokkos::LayoutStride>) {
+    return view.stride(0) == 1;
+  } else {
+    return true;
+  }
+}
+
+} // namespace impl
+
+/**
+ * Read a pack of elements from a rank 1 View.
+ *
+ * Elements of a strided View (e.g. a subview of a column of a
+ * `Kokkos::LayoutRight` View) are gathered one by one.
+ *
+ * @tparam View Type of the View.
+ * @tparam Pack Type of the pack.
+ * @param view View to read from.
+ * @param index Index of the pack.
+ * @return Pack of elements.
+ */
+template <typename View, typename Pack>
+KOKKOS_FUNCTION Pack simdLoad(View const &view,
+                              SimdIndex<Pack> const &index) {
+  static_assert(View::rank == 1, "Only rank 1 Views can be read by packs");
+
+  if constexpr (SimdIndex<Pack>::width == 1) {
+    return view(index.first);
+  } else {
+    Pack pack;
+    if (impl::isContiguous(view)) {
+      pack.copy_from(view.data() + index.first,
+                     Kokkos::Experimental::simd_flag_default);
+    } else {
+      typename Pack::value_type values[SimdIndex<Pack>::width];
+      for (std::size_t i = 0; i < SimdIndex<Pack>::width; i++) {
+        values[i] = view(index.first + i);
+      }
+      pack.copy_from(values, Kokkos::Experimental::simd_flag_default);
+    }
+    return pack;
+  }
+}
+
+/**
+ * Write a pack of elements to a rank 1 View.
+ *
+ * Elements of a strided View are scattered one by one.
+ *
+ * @tparam Pack Type of the pack.
+ * @tparam View Type of the View.
+ * @param pack Pack of elements.
+ * @param view View to write to.
+ * @param index Index of the pack.
+ */
+template <typename Pack, typename View>
+KOKKOS_FUNCTION void simdStore(Pack const &pack, View const &view,
+                               SimdIndex<Pack> const &index) {
+  static_assert(View::rank == 1, "Only rank 1 Views can be written by packs");
+
+  if constexpr (SimdIndex<Pack>::width == 1) {
+    view(index.first) = pack;
+  } else if (impl::isContiguous(view)) {
+    pack.copy_to(view.data() + index.first,
+                 Kokkos::Experimental::simd_flag_default);
+  } else {
+    typename Pack::value_type values[SimdIndex<Pack>::width];
+    pack.copy_to(values, Kokkos::Experimental::simd_flag_default);
+    for (std::size_t i = 0; i < SimdIndex<Pack>::width; i++) {
+      view(index.first + i) = values[i];
+    }
+  }
+}
+
+namespace impl {
+
+/**
+ * Functor calling a kernel for each pack.
+ *
+ * @tparam Pack Type of the pack.
+ * @tparam Kernel Type of the kernel.
+ */
+template <typename Pack, typename Kernel> struct SimdFunctor {
+  Kernel mKernel;
+
+  explicit SimdFunctor(Kernel const &kernel) : mKernel(kernel) {}
+
+  KOKKOS_FUNCTION void operator()(std::size_t const i) const {
+    mKernel(SimdIndex<Pack>{i * SimdIndex<Pack>::width});
+  }
+};
+
+} // namespace impl
+
+/**
+ * Parallel for with explicit SIMD on host, that can be executed dynamically
+ * on device or on host depending on a Boolean parameter.
+ *
+ * On host, the kernel is called with a `dynk::SimdIndex` of
+ * `Kokkos::Experimental::native_simd<Value>` for each full pack, in parallel,
+ * then with a `dynk::SimdIndex` of `Value` for each remaining element, on the
+ * calling thread. On device, it is called with a `dynk::SimdIndex` of `Value`
+ * for each element. The kernel should hence be generic for its argument.
+ *
+ * @tparam Value Type of the elements processed by the kernel.
+ * @tparam Kernel Type of the kernel.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param count Number of elements.
+ * @param kernel Kernel to execute withing a Kokkos parallel for region.
+ */
+template <typename Value, typename Kernel,
+          typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace>
+void simd_for(bool const isExecutedOnDevice, std::string const &label,
+              std::size_t const count, Kernel const &kernel) {
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic simd for"));
+  double const start = impl::getPlacementTime();
+
+  if (isExecutedOnDevice) {
+    // device execution
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<DeviceExecutionSpace,
+                            Kokkos::IndexType<std::size_t>>(
+            impl::getSpace<DeviceExecutionSpace>(), 0, count),
+        impl::SimdFunctor<Value, Kernel>(kernel));
+  } else {
+    // host execution
+    using Pack = Kokkos::Experimental::native_simd<Value>;
+    std::size_t const packs = count / SimdIndex<Pack>::width;
+    auto const space = impl::getSpace<HostExecutionSpace>();
+
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<HostExecutionSpace,
+                            Kokkos::IndexType<std::size_t>>(space, 0, packs),
+        impl::SimdFunctor<Pack, Kernel>(kernel));
+    space.fence(DYNK_LABEL("end of dynamic simd for packs"));
+
+    for (std::size_t i = packs * SimdIndex<Pack>::width; i < count; i++) {
+      kernel(SimdIndex<Value>{i});
+    }
+  }
+
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic simd for"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_SIMD_HPP__
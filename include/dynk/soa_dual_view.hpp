@@ -0,0 +1,286 @@
+#ifndef __DYNK_SOA_DUAL_VIEW_HPP__
+#define __DYNK_SOA_DUAL_VIEW_HPP__
+
+/**
+ * Struct-of-arrays dual container.
+ *
+ * A set of DualViews of the same extents (e.g. the properties of particles)
+ * is declared from a list of field tags, each tag providing the data type of
+ * its field:
+ *
+ * ```cpp
+ * struct Position { using data_type = double *[3]; };
+ * struct Mass { using data_type = double *; };
+ *
+ * dynk::SoADualView<Position, Mass> particles("particles", n);
+ * ```
+ *
+ * Each field is a DualView with its own modify/sync state. Kernels receive an
+ * accessor containing the Views of only the fields they declare, and only
+ * these fields are synchronized or marked as modified.
+ */
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+
+#include "dynk/dual_view.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Index of a field in a list of fields.
+ *
+ * @tparam Field Field to look for.
+ * @tparam Fields List of fields.
+ */
+template <typename Field, typename... Fields> struct FieldIndex;
+
+template <typename Field, typename... Fields>
+struct FieldIndex<Field, Field, Fields...> {
+  static constexpr std::size_t value = 0;
+};
+
+template <typename Field, typename Other, typename... Fields>
+struct FieldIndex<Field, Other, Fields...> {
+  static constexpr std::size_t value = 1 + FieldIndex<Field, Fields...>::value;
+};
+
+/**
+ * View of a field, to be used as a base of an accessor.
+ *
+ * @tparam Field Field tag.
+ * @tparam View Type of the View.
+ */
+template <typename Field, typename View> struct FieldView {
+  View mView;
+};
+
+/**
+ * Get the View of a field from an accessor.
+ *
+ * @tparam Field Field tag.
+ * @tparam View Type of the View, deduced.
+ * @param fieldView Accessor, seen as its base for the field.
+ * @return View of the field.
+ */
+template <typename Field, typename View>
+KOKKOS_FUNCTION View const &
+getFieldView(FieldView<Field, View> const &fieldView) {
+  return fieldView.mView;
+}
+
+} // namespace impl
+
+/**
+ * Lightweight accessor to the Views of some fields of a `dynk::SoADualView`
+ * for one memory space, to be captured by kernels.
+ *
+ * @tparam FieldViews `impl::FieldView` of each field.
+ */
+template <typename... FieldViews> struct SoAAccessor : FieldViews... {
+  /**
+   * Get the View of a field.
+   *
+   * @tparam Field Field tag.
+   * @return View of the field.
+   */
+  template <typename Field> KOKKOS_FUNCTION auto const &get() const {
+    return impl::getFieldView<Field>(*this);
+  }
+
+  /**
+   * Access an element of a field.
+   *
+   * @tparam Field Field tag.
+   * @tparam Indices Type of the indices.
+   * @param indices Indices of the element.
+   * @return Reference to the element.
+   */
+  template <typename Field, typename... Indices>
+  KOKKOS_FUNCTION decltype(auto) operator()(Field,
+                                            Indices const... indices) const {
+    return get<Field>()(indices...);
+  }
+};
+
+/**
+ * Struct-of-arrays container of DualViews, one per field.
+ *
+ * Copies of the container share the same data and the same modification
+ * states, as for a DualView.
+ *
+ * @tparam Fields Field tags, each one defining a `data_type` member type.
+ */
+template <typename... Fields> class SoADualView {
+public:
+  /// Type of the DualView of a field.
+  template <typename Field>
+  using dual_view_type = Kokkos::DualView<typename Field::data_type>;
+
+private:
+  std::tuple<dual_view_type<Fields>...> mDualViews;
+
+  template <std::size_t... indices, typename... Extents>
+  SoADualView(std::index_sequence<indices...>, std::string const &label,
+              Extents const... extents)
+      : mDualViews(dual_view_type<Fields>(
+            label + "[" + std::to_string(indices) + "]", extents...)...) {}
+
+public:
+  SoADualView() = default;
+
+  /**
+   * Allocate the DualViews of all the fields.
+   *
+   * @tparam Extents Type of the extents.
+   * @param label Label of the container, the DualView of the field of index
+   * `i` is labelled `label[i]`.
+   * @param extents Runtime extents, shared by all the fields.
+   */
+  template <typename... Extents>
+  explicit SoADualView(std::string const &label, Extents const... extents)
+      : SoADualView(std::index_sequence_for<Fields...>{}, label, extents...) {}
+
+  /**
+   * Get the DualView of a field.
+   *
+   * @tparam Field Field tag.
+   * @return DualView of the field.
+   */
+  template <typename Field> dual_view_type<Field> &get() {
+    return std::get<impl::FieldIndex<Field, Fields...>::value>(mDualViews);
+  }
+
+  template <typename Field> dual_view_type<Field> const &get() const {
+    return std::get<impl::FieldIndex<Field, Fields...>::value>(mDualViews);
+  }
+
+  /**
+   * Get a runtime extent, shared by all the fields.
+   *
+   * @param dimension Dimension.
+   * @return Extent of the dimension.
+   */
+  std::size_t extent(std::size_t const dimension) const {
+    return std::get<0>(mDualViews).extent(dimension);
+  }
+};
+
+/**
+ * Get an accessor to some fields of a SoADualView for the requested memory
+ * space.
+ *
+ * @tparam MemorySpace Memory space requested.
+ * @tparam Fields Fields to access.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to take the fields from.
+ * @return Accessor to Views in the requested memory space.
+ */
+template <typename MemorySpace, typename... Fields, typename SoADualView>
+auto getAccessor(SoADualView &soaDualView) {
+  return SoAAccessor<impl::FieldView<
+      Fields, decltype(getView<MemorySpace>(
+                  soaDualView.template get<Fields>()))>...>{
+      {getView<MemorySpace>(soaDualView.template get<Fields>())}...};
+}
+
+/**
+ * Get an accessor to some fields of a SoADualView dynamically.
+ *
+ * @tparam Fields Fields to access.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to take the fields from.
+ * @param isExecutedOnDevice If `true`, the accessor contains the device
+ * views, otherwise the host views.
+ * @return Accessor to Views in `Kokkos::AnonymousSpace`.
+ */
+template <typename... Fields, typename SoADualView>
+auto getAccessor(SoADualView &soaDualView, bool const isExecutedOnDevice) {
+  return SoAAccessor<impl::FieldView<
+      Fields, decltype(getView(soaDualView.template get<Fields>(),
+                               isExecutedOnDevice))>...>{
+      {getView(soaDualView.template get<Fields>(), isExecutedOnDevice)}...};
+}
+
+/**
+ * Get an accessor to some fields of a SoADualView for the requested memory
+ * space, and synchronize these fields if needed.
+ *
+ * Other fields are left untouched.
+ *
+ * @tparam MemorySpace Memory space requested.
+ * @tparam Fields Fields to access.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to take the fields from.
+ * @return Accessor to Views in the requested memory space, synchronized.
+ */
+template <typename MemorySpace, typename... Fields, typename SoADualView>
+auto getSyncedAccessor(SoADualView &soaDualView) {
+  return SoAAccessor<impl::FieldView<
+      Fields, decltype(getView<MemorySpace>(
+                  soaDualView.template get<Fields>()))>...>{
+      {getSyncedView<MemorySpace>(soaDualView.template get<Fields>())}...};
+}
+
+/**
+ * Get an accessor to some fields of a SoADualView dynamically, and
+ * synchronize these fields if needed.
+ *
+ * Other fields are left untouched.
+ *
+ * @tparam Fields Fields to access.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to take the fields from.
+ * @param isExecutedOnDevice If `true`, the accessor contains the device
+ * views, otherwise the host views.
+ * @return Accessor to Views in `Kokkos::AnonymousSpace`, synchronized.
+ */
+template <typename... Fields, typename SoADualView>
+auto getSyncedAccessor(SoADualView &soaDualView,
+                       bool const isExecutedOnDevice) {
+  return SoAAccessor<impl::FieldView<
+      Fields, decltype(getView(soaDualView.template get<Fields>(),
+                               isExecutedOnDevice))>...>{
+      {getSyncedView(soaDualView.template get<Fields>(),
+                     isExecutedOnDevice)}...};
+}
+
+/**
+ * Mark some fields of a SoADualView as modified in the requested memory
+ * space.
+ *
+ * @tparam MemorySpace Memory space requested.
+ * @tparam Fields Fields to mark.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to set.
+ */
+template <typename MemorySpace, typename... Fields, typename SoADualView>
+void setFieldsModified(SoADualView &soaDualView) {
+  (setModified<MemorySpace>(soaDualView.template get<Fields>()), ...);
+}
+
+/**
+ * Mark some fields of a SoADualView as modified dynamically.
+ *
+ * @tparam Fields Fields to mark.
+ * @tparam SoADualView Type of the SoADualView.
+ * @param soaDualView SoADualView to set.
+ * @param isExecutedOnDevice If `true`, mark device views as modified,
+ * otherwise mark host views as modified.
+ */
+template <typename... Fields, typename SoADualView>
+void setFieldsModified(SoADualView &soaDualView,
+                       bool const isExecutedOnDevice) {
+  (setModified(soaDualView.template get<Fields>(), isExecutedOnDevice), ...);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_SOA_DUAL_VIEW_HPP__
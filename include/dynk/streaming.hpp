@@ -0,0 +1,274 @@
+#ifndef __DYNK_STREAMING_HPP__
+#define __DYNK_STREAMING_HPP__
+
+/**
+ * Out-of-core streaming.
+ *
+ * DualViews hold a full copy of the data on each side, which is not possible
+ * when the data does not fit in the device memory. This approach proposes a
+ * parallel construct over a large host-resident array that processes it by
+ * chunks on the device: two instances of the device execution space each own
+ * a pair of input and output buffers, and alternate between chunks, so that
+ * the transfers of a chunk on one instance overlap the computation of the
+ * previous chunk on the other one. The kernel works element-wise, and
+ * receives the global index, the input element, and the output element:
+ *
+ * ```cpp
+ * dynk::parallel_for_stream(
+ *     isExecutedOnDevice, "scale", inputV, outputV,
+ *     KOKKOS_LAMBDA(std::size_t const i, double const &in, double &out) {
+ *       out = 2. * in;
+ *     });
+ * ```
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/label.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+
+/**
+ * Parameters of the chunking of `dynk::parallel_for_stream`.
+ *
+ * The chunk size is either set explicitly, or deduced from a memory budget
+ * for the device buffers.
+ */
+class StreamPolicy {
+public:
+  /// Default memory budget for the device buffers, in bytes.
+  static constexpr std::size_t defaultMemoryBudget = 256 * 1024 * 1024;
+
+private:
+  std::size_t mChunkSize = 0;
+  std::size_t mMemoryBudget = defaultMemoryBudget;
+
+public:
+  /**
+   * Set the number of elements of a chunk.
+   *
+   * @param chunkSize Chunk size, 0 deduces it from the memory budget.
+   * @return Reference to the policy.
+   */
+  StreamPolicy &setChunkSize(std::size_t const chunkSize) {
+    mChunkSize = chunkSize;
+    return *this;
+  }
+
+  /**
+   * Set the memory budget for the device buffers, used if no chunk size is
+   * set.
+   *
+   * @param memoryBudget Memory budget, in bytes.
+   * @return Reference to the policy.
+   */
+  StreamPolicy &setMemoryBudget(std::size_t const memoryBudget) {
+    mMemoryBudget = memoryBudget;
+    return *this;
+  }
+
+  /**
+   * Get the number of elements of a chunk.
+   *
+   * @param count Total number of elements.
+   * @param bytesPerElement Size of an input element and an output element, in
+   * bytes.
+   * @return Chunk size, between 1 and the total number of elements.
+   */
+  std::size_t getChunkSize(std::size_t const count,
+                           std::size_t const bytesPerElement) const {
+    // two buffers, each with an input and an output chunk
+    std::size_t const chunkSize =
+        mChunkSize > 0 ? mChunkSize : mMemoryBudget / (2 * bytesPerElement);
+    return std::max<std::size_t>(1, std::min(chunkSize, count));
+  }
+};
+
+namespace impl {
+
+/**
+ * Functor calling an element-wise kernel on a chunk.
+ *
+ * @tparam InputView Type of the input View of the chunk.
+ * @tparam OutputView Type of the output View of the chunk.
+ * @tparam Kernel Type of the kernel.
+ */
+template <typename InputView, typename OutputView, typename Kernel>
+struct StreamFunctor {
+  InputView mInput;
+  OutputView mOutput;
+  std::size_t mOffset;
+  Kernel mKernel;
+
+  StreamFunctor(InputView const &input, OutputView const &output,
+                std::size_t const offset, Kernel const &kernel)
+      : mInput(input), mOutput(output), mOffset(offset), mKernel(kernel) {}
+
+  KOKKOS_FUNCTION void operator()(std::size_t const i) const {
+    mKernel(mOffset + i, mInput(i), mOutput(i));
+  }
+};
+
+/**
+ * Stream a host array by chunks through buffers of a memory space.
+ *
+ * @tparam ExecutionSpace Execution space of the kernels.
+ * @tparam MemorySpace Memory space of the buffers.
+ * @tparam InputView Type of the host input View.
+ * @tparam OutputView Type of the host output View.
+ * @tparam Kernel Type of the kernel.
+ * @param label Label of the kernels.
+ * @param input Host input View.
+ * @param output Host output View.
+ * @param kernel Element-wise kernel.
+ * @param policy Chunking parameters.
+ */
+template <typename ExecutionSpace, typename MemorySpace, typename InputView,
+          typename OutputView, typename Kernel>
+void stream(std::string const &label, InputView const &input,
+            OutputView const &output, Kernel const &kernel,
+            StreamPolicy const &policy) {
+  using InputValue = typename InputView::non_const_value_type;
+  using OutputValue = typename OutputView::non_const_value_type;
+  using InputBuffer = Kokkos::View<InputValue *, MemorySpace>;
+  using OutputBuffer = Kokkos::View<OutputValue *, MemorySpace>;
+
+  std::size_t const count = input.extent(0);
+  if (count == 0) {
+    return;
+  }
+
+  std::size_t const chunkSize =
+      policy.getChunkSize(count, sizeof(InputValue) + sizeof(OutputValue));
+  std::vector<ExecutionSpace> const instances =
+      Kokkos::Experimental::partition_space(getSpace<ExecutionSpace>(), 1, 1);
+
+  std::vector<InputBuffer> inputBuffers;
+  std::vector<OutputBuffer> outputBuffers;
+  for (auto const &instance : instances) {
+    inputBuffers.emplace_back(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, instance,
+                           "dynk stream input"),
+        chunkSize);
+    outputBuffers.emplace_back(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, instance,
+                           "dynk stream output"),
+        chunkSize);
+  }
+
+  // the operations of a chunk are ordered on its instance, and the buffers of
+  // an instance are only reused once its previous chunk is written back
+  for (std::size_t begin = 0, chunk = 0; begin < count;
+       begin += chunkSize, chunk++) {
+    std::size_t const end = std::min(begin + chunkSize, count);
+    std::size_t const buffer = chunk % instances.size();
+    auto const &instance = instances[buffer];
+    auto const chunkRange = std::make_pair(std::size_t(0), end - begin);
+    auto const hostRange = std::make_pair(begin, end);
+
+    auto const inputChunk = Kokkos::subview(inputBuffers[buffer], chunkRange);
+    auto const outputChunk =
+        Kokkos::subview(outputBuffers[buffer], chunkRange);
+
+    Kokkos::deep_copy(instance, inputChunk, Kokkos::subview(input, hostRange));
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<std::size_t>>(
+            instance, 0, end - begin),
+        StreamFunctor<std::remove_const_t<decltype(inputChunk)>,
+                      std::remove_const_t<decltype(outputChunk)>, Kernel>(
+            inputChunk, outputChunk, begin, kernel));
+    Kokkos::deep_copy(instance, Kokkos::subview(output, hostRange),
+                      outputChunk);
+  }
+
+  for (auto const &instance : instances) {
+    instance.fence(DYNK_LABEL("end of dynamic parallel for stream chunks"));
+  }
+}
+
+} // namespace impl
+
+/**
+ * Parallel for streaming a large host array by chunks, that can be executed
+ * dynamically on device or on host depending on a Boolean parameter.
+ *
+ * On device, the input is transferred by chunks to device buffers, the kernel
+ * is executed on each chunk, and the results are transferred back to the
+ * output, with the transfers of a chunk overlapping the computation of the
+ * previous one. Transfers are only asynchronous with respect to the host if
+ * the host arrays are in pinned memory (e.g. `Kokkos::SharedHostPinnedSpace`).
+ * On host, the kernel is executed directly on the arrays.
+ *
+ * The kernel is called for each index with the input element and the output
+ * element, and must write the output element, as the output is entirely
+ * overwritten. The input and the output can be the same array.
+ *
+ * @tparam InputView Type of the input View, a host accessible rank 1 View
+ * (e.g. from `dynk::MappedFile`).
+ * @tparam OutputView Type of the output View, a host accessible rank 1 View.
+ * @tparam Kernel Type of the kernel.
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for the device buffers,
+ * defaults to Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @param isExecutedOnDevice If `true`, the parallel for is executed on the
+ * device, otherwise on the host.
+ * @param label Label of the kernel.
+ * @param input Host input View.
+ * @param output Host output View, of the same extent as the input.
+ * @param kernel Element-wise kernel.
+ * @param policy Chunking parameters, the chunk size is deduced from a memory
+ * budget by default.
+ */
+template <
+    typename InputView, typename OutputView, typename Kernel,
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace>
+void parallel_for_stream(bool const isExecutedOnDevice,
+                         std::string const &label, InputView const &input,
+                         OutputView const &output, Kernel const &kernel,
+                         StreamPolicy const &policy = StreamPolicy()) {
+  static_assert(InputView::rank == 1 && OutputView::rank == 1,
+                "Only rank 1 Views can be streamed");
+
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("begin of dynamic parallel for stream"));
+  double const start = impl::getPlacementTime();
+
+  if (isExecutedOnDevice) {
+    // device execution
+    impl::stream<DeviceExecutionSpace, DeviceMemorySpace>(label, input, output,
+                                                          kernel, policy);
+  } else {
+    // host execution
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<HostExecutionSpace, Kokkos::IndexType<std::size_t>>(
+            impl::getSpace<HostExecutionSpace>(), 0, input.extent(0)),
+        impl::StreamFunctor<InputView, OutputView, Kernel>(input, output, 0,
+                                                           kernel));
+  }
+
+  impl::recordDispatch(isExecutedOnDevice);
+  impl::fence<DeviceExecutionSpace, HostExecutionSpace>(
+      DYNK_LABEL("end of dynamic parallel for stream"));
+  impl::recordPlacement(label, isExecutedOnDevice, start);
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_STREAMING_HPP__
@@ -0,0 +1,352 @@
+#ifndef __DYNK_SYNC_DIAGNOSTICS_HPP__
+#define __DYNK_SYNC_DIAGNOSTICS_HPP__
+
+/**
+ * Synchronization diagnostics.
+ *
+ * When the macro `DYNK_ENABLE_SYNC_DIAGNOSTICS` is defined (with the CMake
+ * option of the same name), the DualView helpers of `dual_view.hpp` and the
+ * dynamic parallel constructs record the modify/sync history of each DualView
+ * they manipulate. A report of the wasted work is printed per DualView label
+ * when Kokkos is finalized. Otherwise, the recording functions are empty and
+ * optimized away.
+ *
+ * The diagnostics only see what goes through Dynk: a DualView synchronized
+ * or modified with its own methods, or a kernel launched with plain Kokkos
+ * outside of `dynk::wrap`, is invisible. The reported numbers are hence
+ * hints, not proofs.
+ */
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+
+/**
+ * Synchronization statistics of all the DualViews sharing a label.
+ */
+struct SyncReport {
+  /// Number of host to device transfers.
+  std::size_t transfersToDevice = 0;
+  /// Number of device to host transfers.
+  std::size_t transfersToHost = 0;
+  /// Number of bytes transferred in both directions.
+  std::size_t bytesTransferred = 0;
+  /// Transfers in the opposite direction of the previous one, with at most
+  /// one kernel in between.
+  std::size_t pingPongs = 0;
+  /// Transfers to a side where no kernel was launched before the data became
+  /// outdated.
+  std::size_t unreadSyncs = 0;
+  /// Views obtained with `dynk::getSyncedView`, used by a kernel, and then
+  /// requested on the other side without any `dynk::setModified` in between;
+  /// if the kernel wrote to the view, the other side reads outdated data.
+  std::size_t missingModifies = 0;
+};
+
+namespace impl {
+
+/**
+ * Registry of the modify/sync history of the DualViews.
+ *
+ * DualViews are identified by their allocation (see `getAllocationKey`), so
+ * that a DualView and its subviews, which share their modification markers,
+ * share their history as well. Their statistics are aggregated by label.
+ * Sides are identified by a Boolean, `true` for the device and `false` for
+ * the host.
+ */
+class SyncDiagnostics {
+  /**
+   * History of a single DualView.
+   */
+  struct State {
+    std::string label;
+    bool hasLastTransfer = false;
+    bool lastTransferIsDevice = false;
+    std::size_t lastTransferDispatch = 0;
+    bool pendingRead[2] = {false, false};
+    std::size_t pendingReadDispatch[2] = {0, 0};
+    bool pendingWrite[2] = {false, false};
+    std::size_t pendingWriteDispatch[2] = {0, 0};
+  };
+
+  mutable std::mutex mMutex;
+  std::map<void const *, State> mStates;
+  std::map<std::string, SyncReport> mReports;
+  std::size_t mDispatches[2] = {0, 0};
+  std::size_t mDispatchesTotal = 0;
+
+  State &getState(void const *key, std::string const &label) {
+    auto &state = mStates[key];
+    state.label = label;
+    return state;
+  }
+
+  /**
+   * Close a pending transfer to a side, which is unread if no kernel was
+   * launched there since.
+   */
+  void closePendingRead(State &state, bool const isDevice) {
+    if (state.pendingRead[isDevice] &&
+        mDispatches[isDevice] == state.pendingReadDispatch[isDevice]) {
+      mReports[state.label].unreadSyncs++;
+    }
+    state.pendingRead[isDevice] = false;
+  }
+
+public:
+  /**
+   * Get the unique instance of the registry.
+   *
+   * On first call, a hook is registered to print the report when Kokkos is
+   * finalized.
+   */
+  static SyncDiagnostics &get() {
+    static SyncDiagnostics instance;
+    static bool const isHookRegistered = [] {
+      Kokkos::push_finalize_hook(
+          [] { SyncDiagnostics::get().printReport(std::cerr); });
+      return true;
+    }();
+    static_cast<void>(isHookRegistered);
+    return instance;
+  }
+
+  /**
+   * Record a synchronization request.
+   *
+   * @param key Key identifying the allocation of the DualView.
+   * @param label Label of the DualView.
+   * @param isDevice Side requested.
+   * @param isTransferred If `true`, data were actually copied.
+   * @param bytes Size of the data.
+   */
+  void onSync(void const *key, std::string const &label, bool const isDevice,
+              bool const isTransferred, std::size_t const bytes) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &state = getState(key, label);
+    auto &report = mReports[label];
+
+    // data written on the other side without being marked as modified
+    if (state.pendingWrite[!isDevice] &&
+        mDispatches[!isDevice] > state.pendingWriteDispatch[!isDevice]) {
+      report.missingModifies++;
+    }
+    state.pendingWrite[!isDevice] = false;
+
+    state.pendingWrite[isDevice] = true;
+    state.pendingWriteDispatch[isDevice] = mDispatches[isDevice];
+
+    if (!isTransferred) {
+      return;
+    }
+
+    if (isDevice) {
+      report.transfersToDevice++;
+    } else {
+      report.transfersToHost++;
+    }
+    report.bytesTransferred += bytes;
+
+    if (state.hasLastTransfer && state.lastTransferIsDevice != isDevice &&
+        mDispatchesTotal - state.lastTransferDispatch <= 1) {
+      report.pingPongs++;
+    }
+    state.hasLastTransfer = true;
+    state.lastTransferIsDevice = isDevice;
+    state.lastTransferDispatch = mDispatchesTotal;
+
+    // data on the other side is now superseded by this side
+    closePendingRead(state, !isDevice);
+    state.pendingRead[isDevice] = true;
+    state.pendingReadDispatch[isDevice] = mDispatches[isDevice];
+  }
+
+  /**
+   * Record a modification.
+   *
+   * @param key Key identifying the allocation of the DualView.
+   * @param label Label of the DualView.
+   * @param isDevice Side modified.
+   */
+  void onModify(void const *key, std::string const &label,
+                bool const isDevice) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &state = getState(key, label);
+
+    state.pendingWrite[isDevice] = false;
+
+    // data transferred to the other side is now outdated
+    closePendingRead(state, !isDevice);
+  }
+
+  /**
+   * Record a kernel launch.
+   *
+   * @param isDevice Side of the launch.
+   */
+  void onDispatch(bool const isDevice) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDispatches[isDevice]++;
+    mDispatchesTotal++;
+  }
+
+  /**
+   * Get the statistics per label.
+   *
+   * Transfers still pending are considered unread if no kernel was launched
+   * on their side since.
+   *
+   * @return Map of statistics, indexed by label.
+   */
+  std::map<std::string, SyncReport> getReports() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto reports = mReports;
+    for (auto const &[key, state] : mStates) {
+      for (bool const isDevice : {false, true}) {
+        if (state.pendingRead[isDevice] &&
+            mDispatches[isDevice] == state.pendingReadDispatch[isDevice]) {
+          reports[state.label].unreadSyncs++;
+        }
+      }
+    }
+    return reports;
+  }
+
+  /**
+   * Forget the whole history.
+   */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStates.clear();
+    mReports.clear();
+    mDispatches[0] = mDispatches[1] = 0;
+    mDispatchesTotal = 0;
+  }
+
+  /**
+   * Print the statistics per label.
+   *
+   * @param stream Output stream.
+   */
+  void printReport(std::ostream &stream) const {
+    auto const reports = getReports();
+    if (reports.empty()) {
+      return;
+    }
+
+    stream << "Dynk synchronization diagnostics\n";
+    stream << std::setw(24) << std::left << "label" << std::right
+           << std::setw(8) << "H->D" << std::setw(8) << "D->H"
+           << std::setw(14) << "bytes"
+           << std::setw(11) << "ping-pong" << std::setw(8) << "unread"
+           << std::setw(16) << "missing modify" << "\n";
+    for (auto const &[label, report] : reports) {
+      stream << std::setw(24) << std::left << label << std::right
+             << std::setw(8) << report.transfersToDevice << std::setw(8)
+             << report.transfersToHost << std::setw(14)
+             << report.bytesTransferred << std::setw(11)
+             << report.pingPongs << std::setw(8) << report.unreadSyncs
+             << std::setw(16) << report.missingModifies << "\n";
+    }
+  }
+};
+
+/**
+ * Record a synchronization request of a DualView before it happens.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView to synchronize.
+ * @param isDevice If `true`, the device side is requested, otherwise the host
+ * side.
+ * @param isSingleAllocation If `true`, both sides of the DualView share a
+ * single allocation, and no data is transferred.
+ */
+template <typename DualView>
+void recordSync([[maybe_unused]] DualView const &dualView,
+                [[maybe_unused]] bool const isDevice,
+                [[maybe_unused]] bool const isSingleAllocation) {
+#ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+  auto const &hostView = dualView.view_host();
+  bool const isTransferred =
+      !isSingleAllocation &&
+      (isDevice ? dualView.need_sync_device() : dualView.need_sync_host());
+  SyncDiagnostics::get().onSync(
+      getAllocationKey(dualView), hostView.label(), isDevice, isTransferred,
+      hostView.span() * sizeof(typename DualView::t_host::value_type));
+#endif // ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+}
+
+/**
+ * Record a modification of a DualView.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView modified.
+ * @param isDevice If `true`, the device side is modified, otherwise the host
+ * side.
+ */
+template <typename DualView>
+void recordModify([[maybe_unused]] DualView const &dualView,
+                  [[maybe_unused]] bool const isDevice) {
+#ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+  SyncDiagnostics::get().onModify(getAllocationKey(dualView),
+                                  dualView.view_host().label(), isDevice);
+#endif // ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+}
+
+/**
+ * Record a kernel launch.
+ *
+ * Called once the kernel is launched, so that a launch that throws is not
+ * counted.
+ *
+ * @param isExecutedOnDevice Side of the launch.
+ */
+inline void recordDispatch([[maybe_unused]] bool const isExecutedOnDevice) {
+#ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+  SyncDiagnostics::get().onDispatch(isExecutedOnDevice);
+#endif // ifdef DYNK_ENABLE_SYNC_DIAGNOSTICS
+}
+
+} // namespace impl
+
+/**
+ * Get the synchronization statistics per label.
+ *
+ * Statistics are only collected if `DYNK_ENABLE_SYNC_DIAGNOSTICS` is defined.
+ *
+ * @return Map of statistics, indexed by DualView label.
+ */
+inline std::map<std::string, SyncReport> getSyncReports() {
+  return impl::SyncDiagnostics::get().getReports();
+}
+
+/**
+ * Print the synchronization statistics per label.
+ *
+ * This is automatically done on the standard error output when Kokkos is
+ * finalized.
+ *
+ * @param stream Output stream.
+ */
+inline void printSyncReport(std::ostream &stream) {
+  impl::SyncDiagnostics::get().printReport(stream);
+}
+
+/**
+ * Forget all the synchronization statistics collected so far.
+ */
+inline void resetSyncDiagnostics() { impl::SyncDiagnostics::get().reset(); }
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_SYNC_DIAGNOSTICS_HPP__
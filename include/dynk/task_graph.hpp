@@ -0,0 +1,723 @@
+#ifndef __DYNK_TASK_GRAPH_HPP__
+#define __DYNK_TASK_GRAPH_HPP__
+
+/**
+ * Task graph approach.
+ *
+ * This approach proposes to submit kernels as tasks declaring the DualViews
+ * they read and write, instead of choosing their side with a Boolean value.
+ * The graph deduces the dependencies between tasks from the DualViews they
+ * access, places each task on the device or on the host with a list
+ * scheduling heuristic aware of the transfers it implies, and executes
+ * independent tasks concurrently on a device and a host execution space
+ * instance:
+ *
+ * ```cpp
+ * dynk::TaskGraph graph;
+ * graph.addTask("advect", n, advectKernel, dynk::reads(velocityDV),
+ *               dynk::readsWrites(densityDV));
+ * graph.addTask("diffuse", n, diffuseKernel, dynk::readsWrites(heatDV));
+ * graph.run();
+ * ```
+ *
+ * The graph synchronizes the DualViews accessed by a task and marks the
+ * written ones as modified, so that kernels created by a
+ * `dynk::KernelFactory` only have to get their Views with `dynk::getView`.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/thread_safety.hpp"
+
+namespace dynk {
+
+/**
+ * Kind of access of a task to a DualView.
+ */
+enum class AccessMode { Read, Write, ReadWrite };
+
+/**
+ * Access of a task to a DualView.
+ *
+ * The DualView must live until the task graph is executed.
+ *
+ * @tparam DualView Type of the DualView.
+ */
+template <typename DualView> class DualViewAccess {
+  DualView *mDualView;
+  AccessMode mMode;
+
+public:
+  DualViewAccess(DualView &dualView, AccessMode const mode)
+      : mDualView(&dualView), mMode(mode) {}
+
+  DualView &getDualView() const { return *mDualView; }
+
+  AccessMode getMode() const { return mMode; }
+};
+
+/**
+ * Declare that a task reads a DualView.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView read.
+ * @return Access.
+ */
+template <typename DualView>
+DualViewAccess<DualView> reads(DualView &dualView) {
+  return {dualView, AccessMode::Read};
+}
+
+/**
+ * Declare that a task overwrites a DualView entirely, without reading it.
+ *
+ * The DualView is not synchronized before the task. As a subview shares the
+ * synchronization state of its whole allocation, a task overwriting only a
+ * subview should declare it with `dynk::readsWrites` instead.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView written.
+ * @return Access.
+ */
+template <typename DualView>
+DualViewAccess<DualView> writes(DualView &dualView) {
+  return {dualView, AccessMode::Write};
+}
+
+/**
+ * Declare that a task reads and writes a DualView.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView read and written.
+ * @return Access.
+ */
+template <typename DualView>
+DualViewAccess<DualView> readsWrites(DualView &dualView) {
+  return {dualView, AccessMode::ReadWrite};
+}
+
+namespace impl {
+
+/**
+ * Get the number of iterations of an integer execution policy.
+ *
+ * @tparam SizeType Type of the indexes.
+ * @param end Last iteration to perform.
+ * @return Number of iterations.
+ */
+template <typename SizeType,
+          typename Enable = std::enable_if_t<std::is_integral_v<SizeType>>>
+double getIterationsCount(SizeType const end) {
+  return static_cast<double>(end);
+}
+
+/**
+ * Get the number of iterations of a Dynk range execution policy.
+ *
+ * @tparam Traits Traits of the Dynk execution policy.
+ * @param executionPolicy Dynk execution policy.
+ * @return Number of iterations.
+ */
+template <typename... Traits>
+double getIterationsCount(RangePolicy<Traits...> const &executionPolicy) {
+  return static_cast<double>(executionPolicy.getEnd() -
+                             executionPolicy.getBegin());
+}
+
+/**
+ * Get the number of iterations of a Dynk multidimensional execution policy.
+ *
+ * @tparam Rank Rank of the multidimensional range.
+ * @tparam Traits Traits of the Dynk execution policy.
+ * @param executionPolicy Dynk execution policy.
+ * @return Number of iterations.
+ */
+template <typename Rank, typename... Traits>
+double
+getIterationsCount(MDRangePolicy<Rank, Traits...> const &executionPolicy) {
+  auto const extents = executionPolicy.getExtents();
+  double count = 1.;
+  for (std::size_t dimension = 0; dimension < Rank::rank; dimension++) {
+    count *= extents[dimension];
+  }
+  return count;
+}
+
+} // namespace impl
+
+/**
+ * Graph of tasks executed dynamically on device or on host.
+ *
+ * Dependencies are deduced in the order of submission: a task depends on the
+ * last task writing a DualView it accesses, and a task writing a DualView
+ * depends on the tasks reading it since its last write. DualViews are
+ * identified by their allocation, so that subviews of the same DualView
+ * depend on each other even if they do not overlap. Unmanaged DualViews are
+ * identified by their data pointer, hence aliasing unmanaged DualViews
+ * starting at different addresses are not seen as dependent.
+ *
+ * Tasks are placed with a list scheduling heuristic similar to HEFT: they
+ * are considered by decreasing upward rank, that is the length of the
+ * longest path to the end of the graph, and each of them is placed on the
+ * side where it finishes the earliest. The finish time accounts for the
+ * availability of the side, the finish time of the dependencies, the
+ * transfer of the DualViews outdated on that side, and the cost of the task.
+ * Costs are estimated from the number of iterations, the throughput and the
+ * latency of each side, unless they are set per task. If the device and host
+ * execution spaces are the same, both sides share the same availability.
+ *
+ * Tasks placed on the same side are executed in order on the instance of
+ * that side, and the instance of the other side is only fenced when a task
+ * depends on it.
+ *
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam DeviceMemorySpace Kokkos memory space for device memory, defaults to
+ * Kokkos default execution space's default memory space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ * @tparam HostMemorySpace Kokkos memory space for host memory, defaults to
+ * Kokkos default host execution space's default memory space.
+ */
+template <
+    typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+    typename DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space,
+    typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace,
+    typename HostMemorySpace = Kokkos::DefaultHostExecutionSpace::memory_space>
+class TaskGraph {
+  /**
+   * Type-erased access to a DualView.
+   */
+  struct Access {
+    void const *mKey;
+    double mBytes;
+    bool mIsRead;
+    bool mIsWritten;
+    bool mIsSingleAllocation;
+    std::function<bool(bool)> mIsOutdated;
+    std::function<void(bool, DeviceExecutionSpace const &,
+                       HostExecutionSpace const &)>
+        mSync;
+    std::function<void(bool)> mSetModified;
+  };
+
+  struct Node {
+    std::string mLabel;
+    double mIterationsCount;
+    std::optional<double> mDeviceCost;
+    std::optional<double> mHostCost;
+    std::optional<bool> mForcedSide;
+    std::vector<Access> mAccesses;
+    std::vector<std::size_t> mPredecessors;
+    std::function<void(bool, DeviceExecutionSpace const &,
+                       HostExecutionSpace const &)>
+        mLaunch;
+    bool mIsExecutedOnDevice = false;
+  };
+
+  /**
+   * Tasks accessing a DualView since its last write.
+   */
+  struct Hazards {
+    std::optional<std::size_t> mLastWriter;
+    std::vector<std::size_t> mReaders;
+  };
+
+  static constexpr bool isSingleResource =
+      std::is_same_v<DeviceExecutionSpace, HostExecutionSpace>;
+
+  DeviceExecutionSpace mDeviceSpace;
+  HostExecutionSpace mHostSpace;
+  std::vector<Node> mTasks;
+  std::map<void const *, Hazards> mHazards;
+  std::vector<std::size_t> mOrder;
+  double mMakespan = 0.;
+  double mDeviceThroughput = 1e10;
+  double mHostThroughput = 1e9;
+  double mDeviceLatency = 5e-6;
+  double mHostLatency = 1e-6;
+  double mBandwidth = 1e10;
+
+  /**
+   * Get the key identifying the data of a DualView.
+   *
+   * Managed DualViews are identified by their allocation record, shared by
+   * their subviews. Unmanaged ones are identified by their host data.
+   */
+  template <typename DualView>
+  static void const *getKey(DualView const &dualView) {
+    void const *const key = impl::getAllocationKey(dualView);
+    return key != nullptr ? key : &dualView;
+  }
+
+  template <typename DualView>
+  static Access createAccess(DualViewAccess<DualView> const &access) {
+    DualView &dualView = access.getDualView();
+    AccessMode const mode = access.getMode();
+
+    Access result;
+    result.mKey = getKey(dualView);
+    result.mBytes = static_cast<double>(
+        dualView.view_host().span() *
+        sizeof(typename DualView::t_host::value_type));
+    result.mIsRead = mode != AccessMode::Write;
+    result.mIsWritten = mode != AccessMode::Read;
+    result.mIsSingleAllocation = impl::isSingleAllocation<DualView>();
+
+    result.mIsOutdated = [&dualView](bool const isForDevice) {
+      return isForDevice ? dualView.need_sync_device()
+                         : dualView.need_sync_host();
+    };
+
+    result.mSync = [&dualView, mode](bool const isForDevice,
+                                     DeviceExecutionSpace const &deviceSpace,
+                                     HostExecutionSpace const &hostSpace) {
+      if (mode == AccessMode::Write) {
+        // previous content is discarded
+        dualView.clear_sync_state();
+        return;
+      }
+
+      impl::recordSync(
+          dualView,
+          isForDevice ? impl::isDeviceSide<DeviceMemorySpace, DualView>()
+                      : impl::isDeviceSide<HostMemorySpace, DualView>(),
+          impl::isSingleAllocation<DualView>());
+
+      if constexpr (impl::isSingleAllocation<DualView>()) {
+        // the kernels of the other side were waited for as dependencies
+        if (isForDevice ? dualView.need_sync_device()
+                        : dualView.need_sync_host()) {
+          dualView.clear_sync_state();
+          if (impl::getSharedPrefetch()) {
+            if (isForDevice) {
+              impl::prefetch<true>(dualView.view_device());
+            } else {
+              impl::prefetch<false>(dualView.view_device());
+            }
+          }
+        }
+      } else if (isForDevice) {
+        // ordered with the kernels of the device instance
+        dualView.sync_device(deviceSpace);
+      } else {
+        dualView.sync_host(hostSpace);
+        hostSpace.fence(DYNK_LABEL("dynk task graph host sync"));
+      }
+    };
+
+    result.mSetModified = [&dualView](bool const isForDevice) {
+      setModified<DeviceMemorySpace, HostMemorySpace>(dualView, isForDevice);
+    };
+
+    return result;
+  }
+
+  double getCost(Node const &task, bool const isForDevice) const {
+    if (isForDevice) {
+      return task.mDeviceCost.value_or(task.mIterationsCount /
+                                           mDeviceThroughput +
+                                       mDeviceLatency);
+    }
+    return task.mHostCost.value_or(task.mIterationsCount / mHostThroughput +
+                                   mHostLatency);
+  }
+
+  /**
+   * Compute the upward rank of each task, in reverse order of submission as
+   * dependencies always come first.
+   */
+  std::vector<double> getUpwardRanks() const {
+    std::vector<double> ranks(mTasks.size(), 0.);
+    for (std::size_t index = mTasks.size(); index-- > 0;) {
+      auto const &task = mTasks[index];
+      ranks[index] += (getCost(task, true) + getCost(task, false)) / 2.;
+
+      for (auto const predecessor : task.mPredecessors) {
+        // data the predecessor writes and the task accesses
+        double bytes = 0.;
+        for (auto const &written : mTasks[predecessor].mAccesses) {
+          for (auto const &access : task.mAccesses) {
+            if (written.mIsWritten && written.mKey == access.mKey &&
+                !written.mIsSingleAllocation) {
+              bytes += written.mBytes;
+            }
+          }
+        }
+        ranks[predecessor] =
+            std::max(ranks[predecessor], ranks[index] + bytes / mBandwidth);
+      }
+    }
+    return ranks;
+  }
+
+  /**
+   * Fence around the execution of the graph.
+   *
+   * In thread-safe mode, only the instances of the calling thread are fenced
+   * instead of fencing globally, so the instances of the graph are fenced as
+   * well.
+   *
+   * @param label Label of the fence.
+   */
+  void fence(Label const &label) const {
+    impl::fence<DeviceExecutionSpace, HostExecutionSpace>(label);
+#ifdef DYNK_ENABLE_THREAD_SAFE
+    mDeviceSpace.fence(label);
+    if constexpr (!isSingleResource) {
+      mHostSpace.fence(label);
+    }
+#endif // ifdef DYNK_ENABLE_THREAD_SAFE
+  }
+
+public:
+  /**
+   * Create an empty task graph.
+   *
+   * @param deviceSpace Execution space instance for device execution, e.g.
+   * obtained with `Kokkos::Experimental::partition_space`, defaults to the
+   * instance of the calling thread in thread-safe mode and to the default
+   * instance otherwise.
+   * @param hostSpace Execution space instance for host execution, with the
+   * same default.
+   */
+  explicit TaskGraph(DeviceExecutionSpace const &deviceSpace =
+                         impl::getSpace<DeviceExecutionSpace>(),
+                     HostExecutionSpace const &hostSpace =
+                         impl::getSpace<HostExecutionSpace>())
+      : mDeviceSpace(deviceSpace), mHostSpace(hostSpace) {}
+
+  /**
+   * Set the throughput of each side used to estimate the cost of tasks.
+   *
+   * @param deviceThroughput Iterations per second on device.
+   * @param hostThroughput Iterations per second on host.
+   * @return Reference to the graph.
+   */
+  TaskGraph &setThroughput(double const deviceThroughput,
+                           double const hostThroughput) {
+    mDeviceThroughput = deviceThroughput;
+    mHostThroughput = hostThroughput;
+    return *this;
+  }
+
+  /**
+   * Set the latency of each side used to estimate the cost of tasks.
+   *
+   * @param deviceLatency Seconds to launch a kernel on device.
+   * @param hostLatency Seconds to launch a kernel on host.
+   * @return Reference to the graph.
+   */
+  TaskGraph &setLatency(double const deviceLatency, double const hostLatency) {
+    mDeviceLatency = deviceLatency;
+    mHostLatency = hostLatency;
+    return *this;
+  }
+
+  /**
+   * Set the bandwidth between the sides used to estimate transfers.
+   *
+   * @param bandwidth Bytes per second.
+   * @return Reference to the graph.
+   */
+  TaskGraph &setBandwidth(double const bandwidth) {
+    mBandwidth = bandwidth;
+    return *this;
+  }
+
+  /**
+   * Add a task executing a parallel for.
+   *
+   * @tparam ExecutionPolicy Type of the Dynk execution policy.
+   * @tparam Kernel Type of the kernel.
+   * @tparam DualViews Types of the DualViews accessed.
+   * @param label Label of the kernel.
+   * @param executionPolicy Object containing the parameters to create a Kokkos
+   * execution policy.
+   * @param kernel Kernel to execute withing a Kokkos parallel for region, or
+   * `dynk::KernelFactory` creating it.
+   * @param accesses Accesses to DualViews, created with `dynk::reads`,
+   * `dynk::writes` or `dynk::readsWrites`.
+   * @return Index of the task.
+   */
+  template <typename ExecutionPolicy, typename Kernel, typename... DualViews>
+  std::size_t addTask(std::string const &label,
+                      ExecutionPolicy const &executionPolicy,
+                      Kernel const &kernel,
+                      DualViewAccess<DualViews> const &...accesses) {
+    std::size_t const index = mTasks.size();
+
+    Node task;
+    task.mLabel = label;
+    task.mIterationsCount = impl::getIterationsCount(executionPolicy);
+    (task.mAccesses.push_back(createAccess(accesses)), ...);
+    task.mLaunch = [label, executionPolicy,
+                    kernel](bool const isExecutedOnDevice,
+                            DeviceExecutionSpace const &deviceSpace,
+                            HostExecutionSpace const &hostSpace) {
+      if (isExecutedOnDevice) {
+        // device execution
+        Kokkos::parallel_for(
+            label,
+            impl::getExecutionPolicy<DeviceExecutionSpace, true>(
+                deviceSpace, executionPolicy),
+            impl::getKernel<DeviceMemorySpace>(kernel));
+      } else {
+        // host execution
+        Kokkos::parallel_for(
+            label,
+            impl::getExecutionPolicy<HostExecutionSpace, false>(
+                hostSpace, executionPolicy),
+            impl::getKernel<HostMemorySpace>(kernel));
+      }
+    };
+
+    // deduce dependencies
+    for (auto const &access : task.mAccesses) {
+      auto &hazards = mHazards[access.mKey];
+      if (hazards.mLastWriter) {
+        task.mPredecessors.push_back(*hazards.mLastWriter);
+      }
+      if (access.mIsWritten) {
+        task.mPredecessors.insert(task.mPredecessors.end(),
+                                  hazards.mReaders.begin(),
+                                  hazards.mReaders.end());
+      }
+    }
+    std::sort(task.mPredecessors.begin(), task.mPredecessors.end());
+    task.mPredecessors.erase(
+        std::unique(task.mPredecessors.begin(), task.mPredecessors.end()),
+        task.mPredecessors.end());
+
+    for (auto const &access : task.mAccesses) {
+      auto &hazards = mHazards[access.mKey];
+      if (access.mIsWritten) {
+        hazards.mLastWriter = index;
+        hazards.mReaders.clear();
+      } else {
+        hazards.mReaders.push_back(index);
+      }
+    }
+
+    mTasks.push_back(std::move(task));
+    return index;
+  }
+
+  /**
+   * Set the cost of a task, superseding its estimation.
+   *
+   * @param task Index of the task.
+   * @param deviceCost Seconds to execute the task on device.
+   * @param hostCost Seconds to execute the task on host.
+   * @return Reference to the graph.
+   */
+  TaskGraph &setCost(std::size_t const task, double const deviceCost,
+                     double const hostCost) {
+    mTasks[task].mDeviceCost = deviceCost;
+    mTasks[task].mHostCost = hostCost;
+    return *this;
+  }
+
+  /**
+   * Force the side of a task.
+   *
+   * @param task Index of the task.
+   * @param isExecutedOnDevice If `true`, the task is executed on the device,
+   * otherwise on the host.
+   * @return Reference to the graph.
+   */
+  TaskGraph &setSide(std::size_t const task, bool const isExecutedOnDevice) {
+    mTasks[task].mForcedSide = isExecutedOnDevice;
+    return *this;
+  }
+
+  std::size_t getSize() const { return mTasks.size(); }
+
+  /**
+   * Get the tasks a task depends on.
+   *
+   * @param task Index of the task.
+   * @return Sorted indices of the dependencies.
+   */
+  std::vector<std::size_t> const &
+  getPredecessors(std::size_t const task) const {
+    return mTasks[task].mPredecessors;
+  }
+
+  /**
+   * Tell on which side a task is placed by the last plan.
+   *
+   * @param task Index of the task.
+   * @return `true` if the task is executed on the device.
+   */
+  bool isExecutedOnDevice(std::size_t const task) const {
+    return mTasks[task].mIsExecutedOnDevice;
+  }
+
+  /**
+   * Get the estimated duration of the last plan.
+   *
+   * @return Seconds.
+   */
+  double getMakespan() const { return mMakespan; }
+
+  /**
+   * Place the tasks on the device or on the host, from the current
+   * synchronization state of the DualViews they access.
+   */
+  void plan() {
+    auto const ranks = getUpwardRanks();
+    mOrder.resize(mTasks.size());
+    std::iota(mOrder.begin(), mOrder.end(), 0);
+    std::stable_sort(mOrder.begin(), mOrder.end(),
+                     [&ranks](std::size_t const left, std::size_t const right) {
+                       return ranks[left] > ranks[right];
+                     });
+
+    // sides where the data of each DualView is valid
+    std::map<void const *, std::pair<bool, bool>> isValid;
+    for (auto const &task : mTasks) {
+      for (auto const &access : task.mAccesses) {
+        isValid.try_emplace(access.mKey, !access.mIsOutdated(true),
+                            !access.mIsOutdated(false));
+      }
+    }
+
+    std::vector<double> finishes(mTasks.size(), 0.);
+    double deviceAvailability = 0.;
+    double hostAvailability = 0.;
+    mMakespan = 0.;
+
+    for (auto const index : mOrder) {
+      auto &task = mTasks[index];
+
+      double dependenciesFinish = 0.;
+      for (auto const predecessor : task.mPredecessors) {
+        dependenciesFinish =
+            std::max(dependenciesFinish, finishes[predecessor]);
+      }
+
+      auto const getFinish = [&](bool const isForDevice) {
+        double transfer = 0.;
+        for (auto const &access : task.mAccesses) {
+          auto const &valid = isValid[access.mKey];
+          bool const isOutdated = isForDevice ? !valid.first : !valid.second;
+          if (access.mIsRead && isOutdated && !access.mIsSingleAllocation) {
+            transfer += access.mBytes / mBandwidth;
+          }
+        }
+        double const availability =
+            isForDevice ? deviceAvailability : hostAvailability;
+        return std::max(availability, dependenciesFinish) + transfer +
+               getCost(task, isForDevice);
+      };
+
+      double const deviceFinish = getFinish(true);
+      double const hostFinish = getFinish(false);
+      task.mIsExecutedOnDevice =
+          task.mForcedSide.value_or(deviceFinish <= hostFinish);
+      double const finish =
+          task.mIsExecutedOnDevice ? deviceFinish : hostFinish;
+      finishes[index] = finish;
+      mMakespan = std::max(mMakespan, finish);
+
+      if (task.mIsExecutedOnDevice || isSingleResource) {
+        deviceAvailability = finish;
+      }
+      if (!task.mIsExecutedOnDevice || isSingleResource) {
+        hostAvailability = finish;
+      }
+
+      for (auto const &access : task.mAccesses) {
+        auto &valid = isValid[access.mKey];
+        if (access.mIsWritten) {
+          valid = {task.mIsExecutedOnDevice, !task.mIsExecutedOnDevice};
+        } else if (task.mIsExecutedOnDevice) {
+          valid.first = true;
+        } else {
+          valid.second = true;
+        }
+      }
+    }
+  }
+
+  /**
+   * Plan and execute the tasks.
+   *
+   * The tasks are kept, so that the graph can be executed again, e.g. at each
+   * step of a simulation, and placed again from the new state of the
+   * DualViews.
+   */
+  void run() {
+    fence(DYNK_LABEL("begin of dynamic task graph"));
+
+    plan();
+
+    // launches on each side, and launches waited for on each side
+    std::size_t launchesCount[2] = {0, 0};
+    std::size_t fencedCount[2] = {0, 0};
+    std::vector<std::size_t> launches(mTasks.size(), 0);
+
+    for (auto const index : mOrder) {
+      auto const &task = mTasks[index];
+      bool const isExecutedOnDevice = task.mIsExecutedOnDevice;
+
+      // wait for the dependencies executed on the other side
+      for (auto const predecessor : task.mPredecessors) {
+        bool const isPredecessorOnDevice =
+            mTasks[predecessor].mIsExecutedOnDevice;
+        if (isPredecessorOnDevice == isExecutedOnDevice ||
+            launches[predecessor] < fencedCount[isPredecessorOnDevice]) {
+          continue;
+        }
+        if (isPredecessorOnDevice) {
+          mDeviceSpace.fence(DYNK_LABEL("dynk task graph dependency"));
+        } else {
+          mHostSpace.fence(DYNK_LABEL("dynk task graph dependency"));
+        }
+        fencedCount[isPredecessorOnDevice] =
+            launchesCount[isPredecessorOnDevice];
+      }
+
+      // tasks are not fenced, only their synchronization and launch are
+      // timed
+      double const start = impl::getPlacementTime();
+      for (auto const &access : task.mAccesses) {
+        access.mSync(isExecutedOnDevice, mDeviceSpace, mHostSpace);
+      }
+
+      task.mLaunch(isExecutedOnDevice, mDeviceSpace, mHostSpace);
+      impl::recordDispatch(isExecutedOnDevice);
+      impl::recordPlacement(task.mLabel, isExecutedOnDevice, start);
+      launches[index] = launchesCount[isExecutedOnDevice]++;
+
+      for (auto const &access : task.mAccesses) {
+        if (access.mIsWritten) {
+          access.mSetModified(isExecutedOnDevice);
+        }
+      }
+    }
+
+    fence(DYNK_LABEL("end of dynamic task graph"));
+  }
+};
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_TASK_GRAPH_HPP__
@@ -0,0 +1,234 @@
+#ifndef __DYNK_THREAD_SAFETY_HPP__
+#define __DYNK_THREAD_SAFETY_HPP__
+
+/**
+ * Thread safety.
+ *
+ * When the macro `DYNK_ENABLE_THREAD_SAFE` is defined (with the CMake option
+ * of the same name), the dynamic constructs (`dynk::parallel_for`,
+ * `dynk::parallel_scatter`, the dynamic algorithms, `dynk::TaskGraph::run`,
+ * etc.) can be called concurrently from several host threads:
+ *
+ * - each calling thread launches its kernels on its own execution space
+ *   instances, created on first use and released by
+ *   `dynk::releaseThreadSpaces` or when Kokkos is finalized;
+ * - the fences before and after these constructs only wait for the instances
+ *   of the calling thread, instead of fencing globally;
+ * - the synchronizations and modification markers of DualViews done by the
+ *   helpers of `dual_view.hpp` are protected by a lock per allocation, and
+ *   data are copied in both directions on the device instance of the calling
+ *   thread.
+ *
+ * Work of a thread is not waited for by the other threads: a DualView
+ * modified by a thread must only be used by another one once both threads
+ * agreed on it, e.g. after a join. Otherwise, the functions of this file
+ * keep the default behavior of fencing globally on the default instances.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+
+#include "dynk/label.hpp"
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Registry of the execution space instances of each thread.
+ *
+ * @tparam ExecutionSpace Type of the execution space.
+ */
+template <typename ExecutionSpace> class ThreadSpaces {
+  mutable std::mutex mMutex;
+  std::map<std::thread::id, ExecutionSpace> mSpaces;
+  bool mIsHookRegistered = false;
+
+public:
+  /**
+   * Get the unique instance of the registry.
+   */
+  static ThreadSpaces &get() {
+    static ThreadSpaces instance;
+    return instance;
+  }
+
+  /**
+   * Get the instance of the calling thread, created on first call.
+   *
+   * When the first instance since Kokkos was initialized is created, a hook
+   * is registered to release the instances when Kokkos is finalized.
+   *
+   * @return Execution space instance.
+   */
+  ExecutionSpace getSpace() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto space = mSpaces.find(std::this_thread::get_id());
+    if (space == mSpaces.end()) {
+      if (!mIsHookRegistered) {
+        Kokkos::push_finalize_hook([] { ThreadSpaces::get().clear(); });
+        mIsHookRegistered = true;
+      }
+      space = mSpaces
+                  .emplace(std::this_thread::get_id(),
+                           Kokkos::Experimental::partition_space(
+                               ExecutionSpace(), 1)[0])
+                  .first;
+    }
+    return space->second;
+  }
+
+  /**
+   * Release the instance of the calling thread, if any.
+   */
+  void release() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSpaces.erase(std::this_thread::get_id());
+  }
+
+  /**
+   * Get the number of threads having an instance.
+   */
+  std::size_t getSize() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mSpaces.size();
+  }
+
+  /**
+   * Release the instances of all threads.
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSpaces.clear();
+    mIsHookRegistered = false;
+  }
+};
+
+/**
+ * Get the execution space instance to launch the kernels of the calling
+ * thread on.
+ *
+ * @tparam ExecutionSpace Type of the execution space.
+ * @return Instance of the calling thread in thread-safe mode, default
+ * instance otherwise.
+ */
+template <typename ExecutionSpace> ExecutionSpace getSpace() {
+#ifdef DYNK_ENABLE_THREAD_SAFE
+  return ThreadSpaces<ExecutionSpace>::get().getSpace();
+#else
+  return ExecutionSpace();
+#endif // ifdef DYNK_ENABLE_THREAD_SAFE
+}
+
+/**
+ * Fence around a dynamic construct.
+ *
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution.
+ * @param label Label of the fence.
+ */
+template <typename DeviceExecutionSpace, typename HostExecutionSpace>
+void fence(Label const &label) {
+#ifdef DYNK_ENABLE_THREAD_SAFE
+  // only the instances of the calling thread
+  getSpace<DeviceExecutionSpace>().fence(label);
+  if constexpr (!std::is_same_v<DeviceExecutionSpace, HostExecutionSpace>) {
+    getSpace<HostExecutionSpace>().fence(label);
+  }
+#else
+  Kokkos::fence(label);
+#endif // ifdef DYNK_ENABLE_THREAD_SAFE
+}
+
+/**
+ * Lock on nothing, used outside of thread-safe mode.
+ */
+struct NoLock {};
+
+/**
+ * Get the key identifying the data of a DualView.
+ *
+ * Managed DualViews are identified by the allocation record of their host
+ * View, shared by their subviews, which also share their modification
+ * markers. Unmanaged ones are identified by their host data.
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView to identify.
+ * @return Key.
+ */
+template <typename DualView>
+void const *getAllocationKey(DualView const &dualView) {
+  auto const &hostView = dualView.view_host();
+  if (void const *const record =
+          hostView.impl_track().template get_record<void>()) {
+    return record;
+  }
+  return hostView.data();
+}
+
+/**
+ * Get the mutex protecting the state of an allocation.
+ *
+ * The mutexes are shared by all DualView types, so that a DualView and its
+ * subviews, constant or of another layout, lock the same mutex.
+ *
+ * @param key Key of the allocation (see `getAllocationKey`).
+ * @return Mutex.
+ */
+inline std::mutex &getAllocationMutex(void const *key) {
+  constexpr std::size_t mutexesCount = 64;
+  static std::mutex mutexes[mutexesCount];
+  return mutexes[std::hash<void const *>()(key) % mutexesCount];
+}
+
+/**
+ * Lock the state of a DualView in thread-safe mode.
+ *
+ * DualViews are identified by their allocation (see `getAllocationKey`), and
+ * share a fixed number of mutexes (see `getAllocationMutex`).
+ *
+ * @tparam DualView Type of the DualView.
+ * @param dualView DualView to lock.
+ * @return Lock, released when destroyed.
+ */
+template <typename DualView>
+[[nodiscard]] auto lockDualView([[maybe_unused]] DualView const &dualView) {
+#ifdef DYNK_ENABLE_THREAD_SAFE
+  return std::unique_lock<std::mutex>(
+      getAllocationMutex(getAllocationKey(dualView)));
+#else
+  return NoLock();
+#endif // ifdef DYNK_ENABLE_THREAD_SAFE
+}
+
+} // namespace impl
+
+/**
+ * Release the execution space instances of the calling thread.
+ *
+ * Instances are otherwise kept until Kokkos is finalized. A short-lived
+ * thread should call this function before exiting, once its work is fenced.
+ * A later dispatch from the thread creates new instances.
+ *
+ * @tparam DeviceExecutionSpace Kokkos execution space for device execution,
+ * defaults to Kokkos default execution space.
+ * @tparam HostExecutionSpace Kokkos execution space for host execution,
+ * defaults to Kokkos default host execution space.
+ */
+template <typename DeviceExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename HostExecutionSpace = Kokkos::DefaultHostExecutionSpace>
+void releaseThreadSpaces() {
+  impl::ThreadSpaces<DeviceExecutionSpace>::get().release();
+  if constexpr (!std::is_same_v<DeviceExecutionSpace, HostExecutionSpace>) {
+    impl::ThreadSpaces<HostExecutionSpace>::get().release();
+  }
+}
+
+} // namespace dynk
+
+#endif // ifndef __DYNK_THREAD_SAFETY_HPP__
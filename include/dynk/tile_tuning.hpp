@@ -0,0 +1,217 @@
+#ifndef __DYNK_TILE_TUNING_HPP__
+#define __DYNK_TILE_TUNING_HPP__
+
+/**
+ * Tile autotuning for multidimensional execution policies.
+ *
+ * The first calls of a kernel with autotuning enabled are executed with each
+ * candidate tile shape in turn, several times per candidate, and timed. The
+ * minimum duration of each candidate is kept, so that first-call effects do
+ * not penalize the first candidates. The fastest candidate is then cached
+ * and used for all subsequent calls. Results are stored per label, per side
+ * and per extents of the range.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+namespace dynk {
+namespace impl {
+
+/**
+ * Registry of tuned tiles for a given rank.
+ *
+ * @tparam rank Rank of the multidimensional range.
+ */
+template <std::size_t rank> class TileTuner {
+public:
+  using Tile = std::array<std::size_t, rank>;
+
+  /**
+   * Number of timed calls per candidate.
+   */
+  static constexpr std::size_t timingsCount = 3;
+
+private:
+  using Key = std::tuple<std::string, bool, Tile>;
+
+  struct Entry {
+    std::vector<Tile> candidates;
+    std::size_t next = 0;
+    std::size_t timings = 0;
+    double time = std::numeric_limits<double>::max();
+    Tile best = {};
+    double bestTime = std::numeric_limits<double>::max();
+  };
+
+  std::mutex mMutex;
+  std::map<Key, Entry> mEntries;
+
+public:
+  /**
+   * Get the unique instance of the registry.
+   */
+  static TileTuner &get() {
+    static TileTuner instance;
+    return instance;
+  }
+
+  /**
+   * Generate candidate tiles for a range.
+   *
+   * The first candidate is a null tile, letting Kokkos decide. The others
+   * take tile sizes of 4, 16, 64 or 256 along each dimension, limited by the
+   * extent of the dimension, with a total number of points within the limit.
+   *
+   * @param extents Extents of the range.
+   * @param maxTotalTileSize Maximum number of points in a tile.
+   * @return Candidate tiles.
+   */
+  static std::vector<Tile> getCandidates(Tile const &extents,
+                                         std::size_t const maxTotalTileSize) {
+    std::vector<Tile> candidates{Tile{}};
+
+    std::size_t const sizes[] = {4, 16, 64, 256};
+    std::size_t const sizesCount = std::size(sizes);
+    std::size_t combinations = 1;
+    for (std::size_t dimension = 0; dimension < rank; dimension++) {
+      combinations *= sizesCount;
+    }
+
+    for (std::size_t combination = 0; combination < combinations;
+         combination++) {
+      Tile tile;
+      std::size_t remainder = combination;
+      std::size_t totalTileSize = 1;
+      for (std::size_t dimension = 0; dimension < rank; dimension++) {
+        std::size_t const size = sizes[remainder % sizesCount];
+        remainder /= sizesCount;
+        tile[dimension] = std::max<std::size_t>(
+            std::min(size, extents[dimension]), std::size_t{1});
+        totalTileSize *= tile[dimension];
+      }
+
+      if (totalTileSize > maxTotalTileSize) {
+        continue;
+      }
+
+      bool isDuplicate = false;
+      for (auto const &candidate : candidates) {
+        isDuplicate = isDuplicate || candidate == tile;
+      }
+      if (!isDuplicate) {
+        candidates.push_back(tile);
+      }
+    }
+
+    return candidates;
+  }
+
+  /**
+   * Get the tile to use for the next call of a kernel.
+   *
+   * @param label Label of the kernel.
+   * @param isForDevice Side of the execution.
+   * @param extents Extents of the range.
+   * @param maxTotalTileSize Maximum number of points in a tile.
+   * @return Pair of the tile, and of a Boolean telling if the call should be
+   * timed and reported with `record`.
+   */
+  std::pair<Tile, bool> getTile(std::string const &label,
+                                bool const isForDevice, Tile const &extents,
+                                std::size_t const maxTotalTileSize) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &entry = mEntries[Key{label, isForDevice, extents}];
+
+    if (entry.candidates.empty()) {
+      entry.candidates = getCandidates(extents, maxTotalTileSize);
+    }
+
+    if (entry.next < entry.candidates.size()) {
+      return {entry.candidates[entry.next], true};
+    }
+
+    return {entry.best, false};
+  }
+
+  /**
+   * Report the duration of a call of a kernel with a candidate tile.
+   *
+   * @param label Label of the kernel.
+   * @param isForDevice Side of the execution.
+   * @param extents Extents of the range.
+   * @param tile Candidate tile used.
+   * @param time Duration of the call in seconds.
+   */
+  void record(std::string const &label, bool const isForDevice,
+              Tile const &extents, Tile const &tile, double const time) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &entry = mEntries[Key{label, isForDevice, extents}];
+
+    if (entry.next >= entry.candidates.size() ||
+        entry.candidates[entry.next] != tile) {
+      // another thread already measured this candidate
+      return;
+    }
+
+    entry.time = std::min(entry.time, time);
+    if (++entry.timings < timingsCount) {
+      return;
+    }
+
+    if (entry.time < entry.bestTime) {
+      entry.bestTime = entry.time;
+      entry.best = tile;
+    }
+    entry.next++;
+    entry.timings = 0;
+    entry.time = std::numeric_limits<double>::max();
+  }
+
+  /**
+   * Get the best tile found for a kernel, if tuning is over.
+   *
+   * @param label Label of the kernel.
+   * @param isForDevice Side of the execution.
+   * @param extents Extents of the range.
+   * @return Best tile, if any.
+   */
+  std::optional<Tile> getBestTile(std::string const &label,
+                                  bool const isForDevice,
+                                  Tile const &extents) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto const entry = mEntries.find(Key{label, isForDevice, extents});
+
+    if (entry == mEntries.end() ||
+        entry->second.next < entry->second.candidates.size()) {
+      return std::nullopt;
+    }
+
+    return entry->second.best;
+  }
+
+  /**
+   * Forget all tuning results.
+   */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+  }
+};
+
+} // namespace impl
+} // namespace dynk
+
+#endif // ifndef __DYNK_TILE_TUNING_HPP__
@@ -53,6 +53,7 @@ void wrap(bool const isExecutedOnDevice,
     // launch for host execution
     parallelLauncher.template operator()<HostExecutionSpace, HostMemorySpace>();
   }
+  impl::recordDispatch(isExecutedOnDevice);
 }
 
 /**
@@ -79,6 +80,7 @@ void wrap(bool const isExecutedOnDevice,
     // launch for host execution
     parallelLauncherHost();
   }
+  impl::recordDispatch(isExecutedOnDevice);
 }
 
 } // namespace dynk
@@ -0,0 +1,157 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/algorithms.hpp"
+
+using DualView = Kokkos::DualView<int *>;
+
+/**
+ * Create a DualView containing 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, modified on
+ * host.
+ */
+DualView createData() {
+  int const values[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+  DualView dataDV("data", 10);
+  for (int i = 0; i < 10; i++) {
+    dataDV.h_view(i) = values[i];
+  }
+  dataDV.template modify<typename DualView::host_mirror_space>();
+  return dataDV;
+}
+
+struct Greater {
+  KOKKOS_FUNCTION bool operator()(int const a, int const b) const {
+    return a > b;
+  }
+};
+
+void test_sort_default(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+
+  dynk::sort(isExecutedOnDevice, dataDV);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(0), 1);
+  EXPECT_EQ(dataDV.h_view(9), 9);
+}
+
+TEST(test_sort, test_default) {
+  test_sort_default(true);
+  test_sort_default(false);
+}
+
+void test_sort_comparator(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+
+  dynk::sort(isExecutedOnDevice, dataDV, Greater{});
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(0), 9);
+  EXPECT_EQ(dataDV.h_view(9), 1);
+}
+
+TEST(test_sort, test_comparator) {
+  test_sort_comparator(true);
+  test_sort_comparator(false);
+}
+
+void test_scan_exclusive(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+  DualView resultDV("result", 10);
+
+  dynk::exclusive_scan(isExecutedOnDevice, dataDV, resultDV, 0);
+
+  resultDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(resultDV.h_view(0), 0);
+  EXPECT_EQ(resultDV.h_view(3), 8);
+  EXPECT_EQ(resultDV.h_view(9), 36);
+}
+
+TEST(test_scan, test_exclusive) {
+  test_scan_exclusive(true);
+  test_scan_exclusive(false);
+}
+
+void test_scan_inclusive(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+
+  dynk::inclusive_scan(isExecutedOnDevice, dataDV, dataDV);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(0), 3);
+  EXPECT_EQ(dataDV.h_view(9), 39);
+}
+
+TEST(test_scan, test_inclusive) {
+  test_scan_inclusive(true);
+  test_scan_inclusive(false);
+}
+
+void test_transform_default(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+  DualView resultDV("result", 10);
+
+  dynk::transform(isExecutedOnDevice, dataDV, resultDV,
+                  KOKKOS_LAMBDA(int const value) { return 2 * value; });
+
+  resultDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(resultDV.h_view(5), 18);
+}
+
+TEST(test_transform, test_default) {
+  test_transform_default(true);
+  test_transform_default(false);
+}
+
+void test_reduce_default(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+
+  EXPECT_EQ(dynk::reduce(isExecutedOnDevice, dataDV), 39);
+}
+
+TEST(test_reduce, test_default) {
+  test_reduce_default(true);
+  test_reduce_default(false);
+}
+
+void test_reduce_min_max(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+
+  EXPECT_EQ(dynk::min_element(isExecutedOnDevice, dataDV), 1u);
+  EXPECT_EQ(dynk::max_element(isExecutedOnDevice, dataDV), 5u);
+}
+
+TEST(test_reduce, test_min_max) {
+  test_reduce_min_max(true);
+  test_reduce_min_max(false);
+}
+
+void test_fill_default(bool const isExecutedOnDevice) {
+  DualView dataDV("data", 10);
+
+  dynk::fill(isExecutedOnDevice, dataDV, 7);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(5), 7);
+}
+
+TEST(test_fill, test_default) {
+  test_fill_default(true);
+  test_fill_default(false);
+}
+
+void test_copy_default(bool const isExecutedOnDevice) {
+  auto dataDV = createData();
+  DualView resultDV("result", 10);
+
+  dynk::copy(isExecutedOnDevice, dataDV, resultDV);
+
+  resultDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(resultDV.h_view(5), 9);
+}
+
+TEST(test_copy, test_default) {
+  test_copy_default(true);
+  test_copy_default(false);
+}
@@ -0,0 +1,90 @@
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/batch.hpp"
+#include "dynk/layer.hpp"
+
+TEST(test_range_batch, test_offsets) {
+  dynk::RangeBatch batch(std::vector<std::pair<std::size_t, std::size_t>>{
+      {0, 10}, {20, 20}, {100, 105}});
+
+  EXPECT_EQ(batch.getRangesCount(), 3u);
+  EXPECT_EQ(batch.getSize(), 15u);
+  EXPECT_EQ(batch.getOffsets().h_view(1), 10u);
+  EXPECT_EQ(batch.getOffsets().h_view(2), 10u);
+  EXPECT_EQ(batch.getBegins().h_view(2), 100u);
+}
+
+TEST(test_range_batch, test_policies) {
+  dynk::RangeBatch batch(
+      std::vector<dynk::RangePolicy<>>{dynk::RangePolicy(5, 8),
+                                       dynk::RangePolicy(0, 4)});
+
+  EXPECT_EQ(batch.getSize(), 7u);
+  EXPECT_EQ(batch.getBegins().h_view(0), 5u);
+}
+
+void test_parallel_for_batch_default(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int **>;
+  DualView dataDV("data", 4, 200);
+
+  // ranges of various sizes, including an empty one
+  dynk::RangeBatch batch(std::vector<std::pair<std::size_t, std::size_t>>{
+      {0, 10}, {20, 20}, {100, 150}, {199, 200}});
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for_batch(
+      isExecutedOnDevice, "label", batch,
+      KOKKOS_LAMBDA(std::size_t const patch, std::size_t const i) {
+        dataV(patch, i) += patch + 1;
+      });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  int count = 0;
+  for (int patch = 0; patch < 4; patch++) {
+    for (int i = 0; i < 200; i++) {
+      count += dataDV.h_view(patch, i) != 0;
+    }
+  }
+  EXPECT_EQ(count, 61);
+  EXPECT_EQ(dataDV.h_view(0, 9), 1);
+  EXPECT_EQ(dataDV.h_view(2, 100), 3);
+  EXPECT_EQ(dataDV.h_view(2, 149), 3);
+  EXPECT_EQ(dataDV.h_view(3, 199), 4);
+}
+
+TEST(test_parallel_for_batch, test_default) {
+  test_parallel_for_batch_default(true);
+  test_parallel_for_batch_default(false);
+}
+
+void test_parallel_for_batch_ranges(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for_batch(
+      isExecutedOnDevice, "label",
+      std::vector<dynk::RangePolicy<>>{dynk::RangePolicy(0, 3),
+                                       dynk::RangePolicy(6, 10)},
+      KOKKOS_LAMBDA(std::size_t const, std::size_t const i) {
+        dataV(i) = i;
+      });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(2), 2);
+  EXPECT_EQ(dataDV.h_view(4), 0);
+  EXPECT_EQ(dataDV.h_view(9), 9);
+}
+
+TEST(test_parallel_for_batch, test_ranges) {
+  test_parallel_for_batch_ranges(true);
+  test_parallel_for_batch_ranges(false);
+}
@@ -0,0 +1,125 @@
+#include <stdexcept>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/coroutine.hpp"
+#include "dynk/layer.hpp"
+
+using DualView = Kokkos::DualView<int *>;
+
+dynk::Task fill(bool const isExecutedOnDevice, DualView &dataDV,
+                int const value) {
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  // kernels are not created within a co_await expression, as some compilers
+  // (e.g. GCC 12) destroy the temporaries of such expressions twice
+  auto const kernel = KOKKOS_LAMBDA(int const i) { dataV(i) = value + i; };
+  co_await dynk::async_for(isExecutedOnDevice, "fill",
+                           dynk::RangePolicy(0, 10), kernel);
+  dynk::setModified(dataDV, isExecutedOnDevice);
+}
+
+TEST(test_is_complete, test_host) {
+#ifndef KOKKOS_ENABLE_HPX
+  // host backends other than HPX finish their kernels when launched
+  Kokkos::DefaultHostExecutionSpace const space;
+  Kokkos::parallel_for(
+      "launch",
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(space, 0, 10),
+      KOKKOS_LAMBDA(int const) {});
+  EXPECT_TRUE(dynk::impl::isComplete(space));
+#endif // ifndef KOKKOS_ENABLE_HPX
+}
+
+void test_async_for_single(bool const isExecutedOnDevice) {
+  DualView dataDV("data", 10);
+
+  dynk::Scheduler scheduler;
+  scheduler.spawn(fill(isExecutedOnDevice, dataDV, 5));
+  scheduler.run();
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), 5 + i);
+  }
+}
+
+TEST(test_async_for, test_single) {
+  test_async_for_single(true);
+  test_async_for_single(false);
+}
+
+TEST(test_async_for, test_interleaved) {
+  // independent work on both sides
+  DualView deviceDV("device data", 10);
+  DualView hostDV("host data", 10);
+
+  dynk::Scheduler scheduler;
+  scheduler.spawn(fill(true, deviceDV, 1));
+  scheduler.spawn(fill(false, hostDV, 2));
+  scheduler.run();
+
+  deviceDV.template sync<typename DualView::host_mirror_space>();
+  hostDV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(deviceDV.h_view(i), 1 + i);
+    EXPECT_EQ(hostDV.h_view(i), 2 + i);
+  }
+}
+
+dynk::Task chain(bool const isExecutedOnDevice, DualView &dataDV,
+                 std::vector<int> &steps, int const id) {
+  auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+
+  // launch, then do host work while the kernel runs
+  auto launch = dynk::async_for(
+      isExecutedOnDevice, "chain", 10,
+      KOKKOS_LAMBDA(int const i) { dataV(i) += 1; });
+  steps.push_back(id);
+  co_await launch;
+
+  auto const kernel = KOKKOS_LAMBDA(int const i) { dataV(i) *= 2; };
+  co_await dynk::async_for(isExecutedOnDevice, "chain", 10, kernel);
+  dynk::setModified(dataDV, isExecutedOnDevice);
+  steps.push_back(id);
+}
+
+void test_async_for_chain(bool const isExecutedOnDevice) {
+  DualView data1DV("data 1", 10);
+  DualView data2DV("data 2", 10);
+  std::vector<int> steps;
+
+  dynk::Scheduler scheduler;
+  scheduler.spawn(chain(isExecutedOnDevice, data1DV, steps, 1));
+  scheduler.spawn(chain(isExecutedOnDevice, data2DV, steps, 2));
+  scheduler.run();
+
+  // both tasks launch their first kernel before any of them continues
+  EXPECT_EQ(steps, (std::vector<int>{1, 2, 1, 2}));
+
+  data1DV.template sync<typename DualView::host_mirror_space>();
+  data2DV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(data1DV.h_view(i), 2);
+    EXPECT_EQ(data2DV.h_view(i), 2);
+  }
+}
+
+TEST(test_async_for, test_chain) {
+  test_async_for_chain(true);
+  test_async_for_chain(false);
+}
+
+dynk::Task fail() {
+  auto const kernel = KOKKOS_LAMBDA(int const) {};
+  co_await dynk::async_for(false, "fail", 1, kernel);
+  throw std::runtime_error("failure");
+}
+
+TEST(test_scheduler, test_exception) {
+  dynk::Scheduler scheduler;
+  scheduler.spawn(fail());
+  EXPECT_THROW(scheduler.run(), std::runtime_error);
+}
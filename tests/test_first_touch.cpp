@@ -0,0 +1,68 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/first_touch.hpp"
+#include "dynk/layer.hpp"
+
+TEST(test_first_touch, test_view) {
+  Kokkos::View<int **, Kokkos::HostSpace> dataV(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "data"), 10, 3);
+  Kokkos::deep_copy(dataV, 1);
+
+  dynk::firstTouch(dataV);
+
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_EQ(dataV(i, j), 0);
+    }
+  }
+}
+
+TEST(test_create_dual_view, test_initialization) {
+  using DualView = Kokkos::DualView<int *>;
+  auto dataDV = dynk::createDualView<DualView>("data", 10);
+
+  EXPECT_EQ(dataDV.extent(0), 10u);
+  EXPECT_EQ(dataDV.view_host().label(), "data");
+  EXPECT_FALSE(dataDV.need_sync_host());
+  EXPECT_FALSE(dataDV.need_sync_device());
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), 0);
+  }
+}
+
+void test_create_dual_view_use(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  auto dataDV = dynk::createDualView<DualView>("data", 10);
+
+  auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label", dynk::RangePolicy(0, 10),
+      KOKKOS_LAMBDA(int const i) { dataV(i) += i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(5), 5);
+}
+
+TEST(test_create_dual_view, test_use) {
+  test_create_dual_view_use(true);
+  test_create_dual_view_use(false);
+}
+
+TEST(test_first_touch, test_view_policy) {
+  Kokkos::View<int **, Kokkos::HostSpace> dataV(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "data"), 10, 3);
+  Kokkos::deep_copy(dataV, 1);
+
+  // with the execution policy of the host kernels using the View
+  dynk::firstTouch(dataV, dynk::MDRangePolicy<Kokkos::Rank<2>>(
+                              {0, 0}, {10, 3}, {5, 3}));
+
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_EQ(dataV(i, j), 0);
+    }
+  }
+}
@@ -0,0 +1,254 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/label.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/wrapper.hpp"
+
+std::string const &getLabelName(std::string const &name) { return name; }
+
+std::atomic<bool> isCountingAllocations{false};
+std::atomic<std::size_t> allocationsCount{0};
+
+/**
+ * Allocate memory for the replaced global allocation functions, counting the
+ * allocation if requested.
+ */
+void *allocate(std::size_t size, std::size_t const alignment) {
+  if (isCountingAllocations.load(std::memory_order_relaxed)) {
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  size = size > 0 ? size : 1;
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+  return std::aligned_alloc(alignment,
+                            (size + alignment - 1) / alignment * alignment);
+}
+
+void *allocateOrThrow(std::size_t const size, std::size_t const alignment) {
+  if (void *const pointer = allocate(size, alignment)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t const size) {
+  return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t const size) {
+  return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t const size, std::align_val_t const alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t const size,
+                     std::align_val_t const alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t const size, std::nothrow_t const &) noexcept {
+  return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t const size, std::nothrow_t const &) noexcept {
+  return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t const size, std::align_val_t const alignment,
+                   std::nothrow_t const &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t const size, std::align_val_t const alignment,
+                     std::nothrow_t const &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *const pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::size_t,
+                     std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::size_t,
+                       std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::nothrow_t const &) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::nothrow_t const &) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::align_val_t,
+                     std::nothrow_t const &) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::align_val_t,
+                       std::nothrow_t const &) noexcept {
+  std::free(pointer);
+}
+
+/**
+ * Count the heap allocations of repeated calls of a function.
+ */
+template <typename Function>
+std::size_t countAllocations(Function const &function,
+                             int const repetitions) {
+  allocationsCount = 0;
+  isCountingAllocations = true;
+  for (int repetition = 0; repetition < repetitions; repetition++) {
+    function();
+  }
+  isCountingAllocations = false;
+  return allocationsCount;
+}
+
+TEST(test_label, test_interning) {
+  dynk::Label const label1("test label interning");
+  dynk::Label const label2(std::string("test label interning"));
+  dynk::Label const label3("test label interning other");
+
+  EXPECT_EQ(label1, label2);
+  EXPECT_NE(label1, label3);
+  EXPECT_EQ(&label1.getName(), &label2.getName());
+  EXPECT_EQ(label1.getName(), "test label interning");
+
+  // the conversion gives the interned string, not a copy
+  EXPECT_EQ(&getLabelName(label1), &label1.getName());
+}
+
+dynk::Label const &getCallSiteLabel() { return DYNK_LABEL("call site"); }
+
+TEST(test_label, test_call_site) {
+  auto const &label1 = getCallSiteLabel();
+  auto const &label2 = getCallSiteLabel();
+
+  EXPECT_EQ(&label1, &label2);
+  EXPECT_EQ(label1, dynk::Label("call site"));
+}
+
+void test_label_parallel_for(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, DYNK_LABEL("label parallel for"), 10,
+      KOKKOS_LAMBDA(int const i) { dataV(i) = i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), i);
+  }
+}
+
+TEST(test_label, test_parallel_for) {
+  test_label_parallel_for(true);
+  test_label_parallel_for(false);
+}
+
+template <typename ExecutionSpace, typename MemorySpace, typename DualView>
+void doParallelForLabel(DualView &dataDV) {
+  auto dataV = dynk::getView<MemorySpace>(dataDV);
+  Kokkos::parallel_for(
+      DYNK_LABEL("label wrap"), Kokkos::RangePolicy<ExecutionSpace>(0, 10),
+      KOKKOS_LAMBDA(int const i) { dataV(i) = 2 * i; });
+  dynk::setModified<MemorySpace>(dataDV);
+}
+
+void test_label_wrap(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  dynk::wrap(
+      isExecutedOnDevice,
+      [&]() {
+        doParallelForLabel<Kokkos::DefaultExecutionSpace,
+                           Kokkos::DefaultExecutionSpace::memory_space>(
+            dataDV);
+      },
+      [&]() {
+        doParallelForLabel<Kokkos::DefaultHostExecutionSpace,
+                           Kokkos::DefaultHostExecutionSpace::memory_space>(
+            dataDV);
+      });
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), 2 * i);
+  }
+}
+
+TEST(test_label, test_wrap) {
+  test_label_wrap(true);
+  test_label_wrap(false);
+}
+
+std::size_t useLabel(std::string const &label) { return label.size(); }
+
+TEST(test_label, test_allocations) {
+  // called through a volatile pointer, so that the allocation is not elided
+  void *(*volatile const allocateFunction)(std::size_t) = &::operator new;
+  auto const allocation = [&]() { ::operator delete(allocateFunction(1)); };
+  std::size_t size = 0;
+  // labels longer than the small string buffer
+  auto const interned = [&]() {
+    size += useLabel(
+        DYNK_LABEL("label that does not fit in the small string buffer"));
+  };
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+  auto dataV = dynk::getView(dataDV, false);
+  auto const kernel = KOKKOS_LAMBDA(int const i) { dataV(i) = i; };
+  auto const launch = [&]() {
+    dynk::parallel_for(
+        false,
+        DYNK_LABEL("label parallel for that does not fit in the buffer"), 10,
+        kernel);
+  };
+
+  // warm up, to exclude interning
+  interned();
+  launch();
+
+  EXPECT_EQ(countAllocations(allocation, 10), 10u);
+  EXPECT_EQ(countAllocations(interned, 10), 0u);
+  EXPECT_EQ(countAllocations(launch, 10), 0u);
+  EXPECT_GT(size, 0u);
+}
@@ -1,3 +1,5 @@
+#include <type_traits>
+
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DualView.hpp>
 #include <gtest/gtest.h>
@@ -97,6 +99,75 @@ TEST(test_parallel_for, test_range_simple) {
   test_parallel_for_range_simple(false);
 }
 
+void test_parallel_for_range_traits(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 100);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label",
+      dynk::RangePolicy<Kokkos::IndexType<int>,
+                        dynk::HostTraits<Kokkos::Schedule<Kokkos::Dynamic>>,
+                        dynk::DeviceTraits<Kokkos::LaunchBounds<128>>>(0, 100)
+          .setHostChunkSize(8)
+          .setDeviceChunkSize(32),
+      KOKKOS_LAMBDA(int const i) { dataV(i) = i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(50), 50);
+}
+
+TEST(test_parallel_for, test_range_traits) {
+  test_parallel_for_range_traits(true);
+  test_parallel_for_range_traits(false);
+}
+
+TEST(test_parallel_for, test_range_traits_per_side) {
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  using Policy = dynk::RangePolicy<
+      Kokkos::IndexType<int>,
+      dynk::HostTraits<Kokkos::Schedule<Kokkos::Dynamic>>,
+      dynk::DeviceTraits<Kokkos::LaunchBounds<128>>>;
+
+  Policy policy(0, 100);
+  policy.setHostChunkSize(8);
+
+  auto hostPolicy = policy.getExecutionPolicy<ExecutionSpace, false>();
+  static_assert(
+      std::is_same_v<decltype(hostPolicy),
+                     Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<int>,
+                                         Kokkos::Schedule<Kokkos::Dynamic>>>);
+  EXPECT_EQ(hostPolicy.chunk_size(), 8);
+
+  auto devicePolicy = policy.getExecutionPolicy<ExecutionSpace, true>();
+  static_assert(
+      std::is_same_v<decltype(devicePolicy),
+                     Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<int>,
+                                         Kokkos::LaunchBounds<128>>>);
+}
+
+struct WorkTag {};
+
+void test_parallel_for_range_work_tag(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label", dynk::RangePolicy<WorkTag>(0, 10),
+      KOKKOS_LAMBDA(WorkTag, int const i) { dataV(i) = i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(5), 5);
+}
+
+TEST(test_parallel_for, test_range_work_tag) {
+  test_parallel_for_range_work_tag(true);
+  test_parallel_for_range_work_tag(false);
+}
+
 void test_parallel_for_mdrange(bool const isExecutedOnDevice) {
   using DualView = Kokkos::DualView<int **>;
   DualView dataDV("data", 10, 10);
@@ -137,6 +208,170 @@ TEST(test_parallel_for, test_mdrange_tile) {
   test_parallel_for_mdrange_tile(false);
 }
 
+void test_parallel_for_mdrange_tile_per_side(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int **>;
+  DualView dataDV("data", 10, 10);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label",
+      dynk::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {10, 10})
+          .setDeviceTile({2, 5})
+          .setHostTile({10, 1}),
+      KOKKOS_LAMBDA(int const i, int const j) { dataV(i, j) = i * 100 + j; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(4, 6), 406);
+}
+
+TEST(test_parallel_for, test_mdrange_tile_per_side) {
+  test_parallel_for_mdrange_tile_per_side(true);
+  test_parallel_for_mdrange_tile_per_side(false);
+}
+
+TEST(test_tile_tuning, test_candidates) {
+  using Tuner = dynk::impl::TileTuner<2>;
+
+  auto const candidates = Tuner::getCandidates({10, 1000}, 256);
+
+  // first candidate lets Kokkos decide
+  EXPECT_EQ(candidates.front()[0], 0u);
+  EXPECT_EQ(candidates.front()[1], 0u);
+
+  for (std::size_t i = 1; i < candidates.size(); i++) {
+    EXPECT_LE(candidates[i][0], 10u);
+    EXPECT_LE(candidates[i][0] * candidates[i][1], 256u);
+  }
+}
+
+void test_parallel_for_mdrange_autotuning_call(bool const isExecutedOnDevice,
+                                              int const call) {
+  using DualView = Kokkos::DualView<int **>;
+  DualView dataDV("data", 100, 100);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "autotuned",
+      dynk::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {100, 100})
+          .enableTileAutotuning(),
+      KOKKOS_LAMBDA(int const i, int const j) {
+        dataV(i, j) = i * 100 + j + call;
+      });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(4, 6), 406 + call);
+}
+
+void test_parallel_for_mdrange_autotuning(bool const isExecutedOnDevice) {
+  using Tuner = dynk::impl::TileTuner<2>;
+
+  int const candidatesCount =
+      Tuner::getCandidates({100, 100},
+                           isExecutedOnDevice
+                               ? dynk::impl::maxTotalTileSizeDevice
+                               : dynk::impl::maxTotalTileSizeHost)
+          .size();
+
+  // several calls per candidate
+  int const callsCount = candidatesCount * Tuner::timingsCount;
+  for (int call = 0; call < callsCount; call++) {
+    EXPECT_FALSE(Tuner::get()
+                     .getBestTile("autotuned", isExecutedOnDevice, {100, 100})
+                     .has_value());
+    test_parallel_for_mdrange_autotuning_call(isExecutedOnDevice, call);
+  }
+
+  EXPECT_TRUE(Tuner::get()
+                  .getBestTile("autotuned", isExecutedOnDevice, {100, 100})
+                  .has_value());
+
+  // call with the best tile
+  test_parallel_for_mdrange_autotuning_call(isExecutedOnDevice, callsCount);
+}
+
+TEST(test_parallel_for, test_mdrange_autotuning_max_tile_size) {
+  using Policy = Kokkos::MDRangePolicy<Kokkos::Rank<2>>;
+  using BoundedPolicy =
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::LaunchBounds<64>>;
+
+  EXPECT_EQ((dynk::impl::getMaxTotalTileSize<Policy, true>()),
+            dynk::impl::maxTotalTileSizeDevice);
+  EXPECT_EQ((dynk::impl::getMaxTotalTileSize<BoundedPolicy, true>()), 64u);
+  EXPECT_EQ((dynk::impl::getMaxTotalTileSize<BoundedPolicy, false>()),
+            dynk::impl::maxTotalTileSizeHost);
+}
+
+TEST(test_parallel_for, test_mdrange_autotuning) {
+  dynk::impl::TileTuner<2>::get().reset();
+  test_parallel_for_mdrange_autotuning(true);
+  test_parallel_for_mdrange_autotuning(false);
+}
+
+template <typename View> struct ParallelForRangeFunctor {
+  View mDataV;
+
+  explicit ParallelForRangeFunctor(View const dataV) : mDataV(dataV) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const { mDataV(i) += i; }
+};
+
+void test_parallel_for_range_kernel_factory(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  // pre-alter data
+  auto dataAlteration = dataDV.template view<Kokkos::HostSpace>();
+  Kokkos::deep_copy(dataAlteration, 10);
+  dataDV.template modify<Kokkos::HostSpace>();
+
+  dynk::parallel_for(isExecutedOnDevice, "label", dynk::RangePolicy(0, 10),
+                     dynk::KernelFactory([&](auto memorySpace) {
+                       using MemorySpace = decltype(memorySpace);
+                       auto dataV = dynk::getSyncedView<MemorySpace>(dataDV);
+                       static_assert(std::is_same_v<
+                                     typename decltype(dataV)::memory_space,
+                                     MemorySpace>);
+                       return ParallelForRangeFunctor(dataV);
+                     }));
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(5), 15);
+}
+
+TEST(test_parallel_for, test_range_kernel_factory) {
+  test_parallel_for_range_kernel_factory(true);
+  test_parallel_for_range_kernel_factory(false);
+}
+
+#ifdef ENABLE_EXTENDED_LAMBDA_IN_GENERIC_LAMBDA
+
+void test_parallel_for_range_kernel_factory_lambda(
+    bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  dynk::parallel_for(
+      isExecutedOnDevice, "label", dynk::RangePolicy(0, 10),
+      dynk::KernelFactory([&](auto memorySpace) {
+        auto dataV = dynk::getView<decltype(memorySpace)>(dataDV);
+        return KOKKOS_LAMBDA(int const i) { dataV(i) = i; };
+      }));
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(dataDV.h_view(5), 5);
+}
+
+TEST(test_parallel_for, test_range_kernel_factory_lambda) {
+  test_parallel_for_range_kernel_factory_lambda(true);
+  test_parallel_for_range_kernel_factory_lambda(false);
+}
+
+#endif // ifdef ENABLE_EXTENDED_LAMBDA_IN_GENERIC_LAMBDA
+
 void test_parallel_reduce_range(bool const isExecutedOnDevice) {
   using DualView = Kokkos::DualView<int *>;
   DualView dataDV("data", 10);
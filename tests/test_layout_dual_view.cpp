@@ -0,0 +1,164 @@
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/layout_dual_view.hpp"
+
+using LayoutDualView = dynk::LayoutDualView<int **>;
+
+template <typename View> struct ParallelForMDRangeFunctor {
+  View mDataV;
+
+  explicit ParallelForMDRangeFunctor(View const dataV) : mDataV(dataV) {}
+
+  KOKKOS_FUNCTION void operator()(int const i, int const j) const {
+    mDataV(i, j) += 10 * i + j;
+  }
+};
+
+TEST(test_transpose, test_default) {
+  using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+  Kokkos::View<int **, Kokkos::LayoutRight, Kokkos::HostSpace> sourceV(
+      "source", 40, 30);
+  Kokkos::View<int **, Kokkos::LayoutLeft, Kokkos::HostSpace> destinationV(
+      "destination", 40, 30);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 30; j++) {
+      sourceV(i, j) = 100 * i + j;
+    }
+  }
+
+  dynk::impl::transpose<ExecutionSpace, false>(ExecutionSpace(), destinationV,
+                                               sourceV);
+  ExecutionSpace().fence();
+
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 30; j++) {
+      EXPECT_EQ(destinationV(i, j), 100 * i + j);
+    }
+  }
+}
+
+TEST(test_layout_dual_view, test_types) {
+  using DeviceSpace = Kokkos::DefaultExecutionSpace::memory_space;
+
+  static_assert(std::is_same_v<typename LayoutDualView::t_host::array_layout,
+                               Kokkos::LayoutRight>);
+  static_assert(LayoutDualView::isSingleSpace ||
+                std::is_same_v<typename LayoutDualView::t_dev::array_layout,
+                               Kokkos::LayoutLeft>);
+
+  LayoutDualView dataDV("data", 4, 3);
+  EXPECT_EQ(dataDV.extent(0), 4u);
+  EXPECT_EQ(dataDV.extent(1), 3u);
+  EXPECT_EQ(dynk::getView<DeviceSpace>(dataDV).data(), dataDV.d_view.data());
+  EXPECT_EQ(dynk::getView<Kokkos::HostSpace>(dataDV).data(),
+            dataDV.h_view.data());
+}
+
+TEST(test_layout_dual_view, test_sync_state) {
+  LayoutDualView dataDV("data", 4, 3);
+  EXPECT_FALSE(dataDV.need_sync_device());
+  EXPECT_FALSE(dataDV.need_sync_host());
+
+  dataDV.modify_host();
+  EXPECT_TRUE(dataDV.need_sync_device());
+  EXPECT_FALSE(dataDV.need_sync_host());
+
+  // copies share the modification state
+  auto copyDV = dataDV;
+  copyDV.sync_device();
+  EXPECT_FALSE(dataDV.need_sync_device());
+
+  dataDV.modify_device();
+  EXPECT_TRUE(copyDV.need_sync_host());
+}
+
+TEST(test_layout_dual_view, test_sync_on_instance) {
+  Kokkos::DefaultExecutionSpace const space;
+  LayoutDualView dataDV("data", 4, 3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      dataDV.h_view(i, j) = 10 * i + j;
+    }
+  }
+
+  // round trip through the device side, transposed on the given instance
+  dataDV.modify_host();
+  dataDV.sync_device(space);
+  EXPECT_FALSE(dataDV.need_sync_device());
+  Kokkos::deep_copy(dataDV.h_view, 0);
+  dataDV.modify_device();
+  dataDV.sync_host(space);
+  EXPECT_FALSE(dataDV.need_sync_host());
+
+  if (!LayoutDualView::isSingleSpace) {
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 3; j++) {
+        EXPECT_EQ(dataDV.h_view(i, j), 10 * i + j);
+      }
+    }
+  }
+}
+
+void test_layout_dual_view_kernel_factory(bool const isExecutedOnDevice) {
+  LayoutDualView dataDV("data", 4, 3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      dataDV.h_view(i, j) = 1;
+    }
+  }
+  dataDV.modify_host();
+
+  dynk::parallel_for(
+      isExecutedOnDevice, "label",
+      dynk::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {4, 3}),
+      dynk::KernelFactory([&](auto memorySpace) {
+        using MemorySpace = decltype(memorySpace);
+        return ParallelForMDRangeFunctor(
+            dynk::getSyncedView<MemorySpace>(dataDV));
+      }));
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.sync_host();
+  EXPECT_EQ(dataDV.h_view(2, 1), 22);
+  EXPECT_EQ(dataDV.h_view(3, 2), 33);
+}
+
+TEST(test_layout_dual_view, test_kernel_factory) {
+  test_layout_dual_view_kernel_factory(true);
+  test_layout_dual_view_kernel_factory(false);
+}
+
+void test_layout_dual_view_anonymous(bool const isExecutedOnDevice) {
+  LayoutDualView dataDV("data", 4, 3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      dataDV.h_view(i, j) = 1;
+    }
+  }
+  dataDV.modify_host();
+
+  auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(isExecutedOnDevice, "label",
+                     dynk::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {4, 3}),
+                     ParallelForMDRangeFunctor(dataV));
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  dataDV.sync_host();
+  EXPECT_EQ(dataDV.h_view(2, 1), 22);
+}
+
+TEST(test_layout_dual_view, test_const) {
+  LayoutDualView const dataDV("data", 4, 3);
+
+  EXPECT_EQ(dynk::getView(dataDV, true).data(), dataDV.d_view.data());
+  EXPECT_EQ(dynk::getView(dataDV, false).data(), dataDV.h_view.data());
+}
+
+TEST(test_layout_dual_view, test_anonymous) {
+  test_layout_dual_view_anonymous(true);
+  test_layout_dual_view_anonymous(false);
+}
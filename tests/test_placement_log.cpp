@@ -0,0 +1,163 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/placement_log.hpp"
+#include "dynk/task_graph.hpp"
+
+TEST(test_placement_log, test_file) {
+  std::string const path = testing::TempDir() + "dynk_placement_file.bin";
+  std::vector<dynk::PlacementRecord> const records = {
+      {"a", 0, true, 1.5}, {"b", 0, false, 2.}, {"a", 1, false, 0.5}};
+
+  dynk::writePlacementLog(path, records);
+  auto const readRecords = dynk::readPlacementLog(path);
+
+  ASSERT_EQ(readRecords.size(), 3u);
+  for (std::size_t i = 0; i < records.size(); i++) {
+    EXPECT_EQ(readRecords[i].label, records[i].label);
+    EXPECT_EQ(readRecords[i].callIndex, records[i].callIndex);
+    EXPECT_EQ(readRecords[i].isExecutedOnDevice,
+              records[i].isExecutedOnDevice);
+    EXPECT_EQ(readRecords[i].time, records[i].time);
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(test_placement_log, test_invalid_file) {
+  std::string const path = testing::TempDir() + "dynk_placement_invalid.bin";
+  {
+    std::ofstream stream(path);
+    stream << "not a placement log";
+  }
+
+  EXPECT_THROW(dynk::readPlacementLog(path), std::runtime_error);
+
+  // corrupted number of records
+  {
+    std::ofstream stream(path, std::ios::binary);
+    stream.write(dynk::impl::placementLogMagic,
+                 sizeof(dynk::impl::placementLogMagic));
+    dynk::impl::writeValue(stream, dynk::impl::placementLogVersion);
+    dynk::impl::writeValue(stream, std::uint32_t(0));
+    dynk::impl::writeValue(stream, std::uint64_t(1) << 60);
+  }
+  EXPECT_THROW(dynk::readPlacementLog(path), std::runtime_error);
+
+  EXPECT_THROW(dynk::readPlacementLog(testing::TempDir() +
+                                      "dynk_placement_missing.bin"),
+               std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+TEST(test_placement_log, test_record) {
+  std::string const path = testing::TempDir() + "dynk_placement_record.bin";
+
+  dynk::startPlacementRecording(path);
+  auto const kernel = KOKKOS_LAMBDA(int const) {};
+  dynk::parallel_for(true, "a", 10, kernel);
+  dynk::parallel_for(false, "b", 10, kernel);
+  int sum = 0;
+  dynk::parallel_reduce(
+      false, "a", 10, KOKKOS_LAMBDA(int const i, int &partialSum) {
+        partialSum += i;
+      },
+      sum);
+  dynk::stopPlacementLog();
+
+  auto const records = dynk::readPlacementLog(path);
+  ASSERT_EQ(records.size(), 3u);
+  EXPECT_EQ(records[0].label, "a");
+  EXPECT_EQ(records[0].callIndex, 0u);
+  EXPECT_TRUE(records[0].isExecutedOnDevice);
+  EXPECT_EQ(records[1].label, "b");
+  EXPECT_EQ(records[1].callIndex, 0u);
+  EXPECT_FALSE(records[1].isExecutedOnDevice);
+  EXPECT_EQ(records[2].label, "a");
+  EXPECT_EQ(records[2].callIndex, 1u);
+  EXPECT_FALSE(records[2].isExecutedOnDevice);
+  for (auto const &record : records) {
+    EXPECT_GE(record.time, 0.);
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(test_placement_log, test_record_task_graph) {
+  std::string const path = testing::TempDir() + "dynk_placement_graph.bin";
+  Kokkos::DualView<int *> xDV("x", 10);
+  Kokkos::DualView<int *> yDV("y", 10);
+
+  dynk::TaskGraph graph;
+  auto const kernel = KOKKOS_LAMBDA(int const) {};
+  graph.addTask("a", 10, kernel, dynk::writes(xDV));
+  graph.addTask("b", 10, kernel, dynk::writes(yDV));
+  graph.setSide(0, true).setSide(1, false);
+
+  dynk::startPlacementRecording(path);
+  graph.run();
+  dynk::stopPlacementLog();
+
+  // tasks are recorded on the side chosen by the plan
+  auto const records = dynk::readPlacementLog(path);
+  ASSERT_EQ(records.size(), 2u);
+  for (auto const &record : records) {
+    EXPECT_EQ(record.isExecutedOnDevice, record.label == "a");
+    EXPECT_EQ(record.callIndex, 0u);
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(test_placement_log, test_replay) {
+  std::string const path = testing::TempDir() + "dynk_placement_replay.bin";
+  dynk::writePlacementLog(path, {{"a", 0, false, 0.}, {"a", 1, true, 0.}});
+
+  dynk::startPlacementReplay(path);
+  EXPECT_FALSE(dynk::place("a", true));
+  EXPECT_TRUE(dynk::place("a", false));
+  // beyond the recorded calls, or unknown label
+  EXPECT_FALSE(dynk::place("a", false));
+  EXPECT_TRUE(dynk::place("b", true));
+  dynk::stopPlacementLog();
+
+  EXPECT_TRUE(dynk::place("a", true));
+
+  std::remove(path.c_str());
+}
+
+TEST(test_placement_log, test_diff) {
+  std::vector<dynk::PlacementRecord> const first = {
+      {"a", 0, true, 1.}, {"a", 1, true, 1.}, {"b", 0, false, 3.}};
+  std::vector<dynk::PlacementRecord> const second = {
+      {"a", 0, true, 1.}, {"a", 1, false, 2.}, {"c", 0, true, 4.}};
+
+  auto const differences = dynk::diffPlacementLogs(first, second);
+  ASSERT_EQ(differences.size(), 3u);
+
+  auto const &a = differences.at("a");
+  EXPECT_EQ(a.callsCount[0], 2u);
+  EXPECT_EQ(a.callsCount[1], 2u);
+  EXPECT_EQ(a.deviceCallsCount[0], 2u);
+  EXPECT_EQ(a.deviceCallsCount[1], 1u);
+  EXPECT_EQ(a.sideChangesCount, 1u);
+  EXPECT_EQ(a.time[0], 2.);
+  EXPECT_EQ(a.time[1], 3.);
+
+  auto const &b = differences.at("b");
+  EXPECT_EQ(b.callsCount[0], 1u);
+  EXPECT_EQ(b.callsCount[1], 0u);
+  EXPECT_EQ(b.time[0], 3.);
+
+  EXPECT_EQ(differences.at("c").callsCount[1], 1u);
+}
@@ -0,0 +1,62 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <Kokkos_ScatterView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/scatter_view.hpp"
+
+void test_parallel_scatter_histogram(bool const isExecutedOnDevice,
+                                     dynk::ScatterStrategy const strategy) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 100);
+  DualView binsDV("bins", 10);
+
+  auto dataV = dynk::getView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "fill", dynk::RangePolicy(0, 100),
+      KOKKOS_LAMBDA(int const i) { dataV(i) = i % 10; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  // pre-alter bins on host, contributions should be added to them
+  Kokkos::deep_copy(binsDV.h_view, 1);
+  binsDV.template modify<typename DualView::host_mirror_space>();
+
+  dynk::parallel_scatter(
+      isExecutedOnDevice, "histogram", dynk::RangePolicy(0, 100), binsDV,
+      KOKKOS_LAMBDA(int const i, auto &access) { access(dataV(i)) += 1; },
+      strategy);
+
+  binsDV.template sync<typename DualView::host_mirror_space>();
+  for (int bin = 0; bin < 10; bin++) {
+    EXPECT_EQ(binsDV.h_view(bin), 11);
+  }
+}
+
+TEST(test_parallel_scatter, test_histogram) {
+  for (auto const strategy :
+       {dynk::ScatterStrategy::Automatic, dynk::ScatterStrategy::Duplicated,
+        dynk::ScatterStrategy::Atomic}) {
+    test_parallel_scatter_histogram(true, strategy);
+    test_parallel_scatter_histogram(false, strategy);
+  }
+}
+
+void test_parallel_scatter_max(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView maxDV("max", 10);
+
+  dynk::parallel_scatter<Kokkos::Experimental::ScatterMax>(
+      isExecutedOnDevice, "max", dynk::RangePolicy(0, 100), maxDV,
+      KOKKOS_LAMBDA(int const i, auto &access) {
+        access(i % 10).update(i);
+      });
+
+  maxDV.template sync<typename DualView::host_mirror_space>();
+  EXPECT_EQ(maxDV.h_view(5), 95);
+}
+
+TEST(test_parallel_scatter, test_max) {
+  test_parallel_scatter_max(true);
+  test_parallel_scatter_max(false);
+}
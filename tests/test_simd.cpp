@@ -0,0 +1,71 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <Kokkos_SIMD.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/simd.hpp"
+
+TEST(test_simd_index, test_width) {
+  using Pack = Kokkos::Experimental::native_simd<double>;
+
+  static_assert(dynk::SimdIndex<double>::width == 1);
+  static_assert(dynk::SimdIndex<Pack>::width == Pack::size());
+}
+
+void test_simd_for_triad(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<double *>;
+  // not a multiple of the pack width, to have a remainder
+  int const size = 103;
+  DualView aDV("a", size);
+  DualView bDV("b", size);
+  DualView cDV("c", size);
+  for (int i = 0; i < size; i++) {
+    bDV.h_view(i) = i;
+    cDV.h_view(i) = 2 * i;
+  }
+  bDV.template modify<typename DualView::host_mirror_space>();
+  cDV.template modify<typename DualView::host_mirror_space>();
+
+  auto aV = dynk::getView(aDV, isExecutedOnDevice);
+  auto bV = dynk::getSyncedView(bDV, isExecutedOnDevice);
+  auto cV = dynk::getSyncedView(cDV, isExecutedOnDevice);
+  dynk::simd_for<double>(
+      isExecutedOnDevice, "triad", size, KOKKOS_LAMBDA(auto const index) {
+        auto const b = dynk::simdLoad(bV, index);
+        auto const c = dynk::simdLoad(cV, index);
+        dynk::simdStore(b + 3. * c, aV, index);
+      });
+  dynk::setModified(aDV, isExecutedOnDevice);
+
+  aDV.template sync<typename DualView::host_mirror_space>();
+  for (int i = 0; i < size; i++) {
+    EXPECT_EQ(aDV.h_view(i), 7. * i);
+  }
+}
+
+TEST(test_simd_for, test_triad) {
+  test_simd_for_triad(true);
+  test_simd_for_triad(false);
+}
+
+TEST(test_simd_for, test_strided) {
+  using View = Kokkos::View<double *, Kokkos::LayoutStride, Kokkos::HostSpace>;
+  int const size = 103;
+  Kokkos::View<double *, Kokkos::HostSpace> dataV("data", 2 * size);
+  for (int i = 0; i < 2 * size; i++) {
+    dataV(i) = i;
+  }
+
+  // every other element, read and written by packs
+  View const stridedV(dataV.data(), Kokkos::LayoutStride(size, 2));
+  dynk::simd_for<double>(
+      false, "strided", size, KOKKOS_LAMBDA(auto const index) {
+        dynk::simdStore(2. * dynk::simdLoad(stridedV, index), stridedV,
+                        index);
+      });
+
+  for (int i = 0; i < 2 * size; i++) {
+    EXPECT_EQ(dataV(i), i % 2 == 0 ? 2. * i : i);
+  }
+}
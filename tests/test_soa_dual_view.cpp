@@ -0,0 +1,120 @@
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/soa_dual_view.hpp"
+
+struct Position {
+  using data_type = double *[3];
+};
+
+struct Mass {
+  using data_type = double *;
+};
+
+struct Charge {
+  using data_type = int *;
+};
+
+using Particles = dynk::SoADualView<Position, Mass, Charge>;
+
+template <typename Accessor> struct MoveFunctor {
+  Accessor mAccessor;
+
+  explicit MoveFunctor(Accessor const &accessor) : mAccessor(accessor) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const {
+    mAccessor(Position{}, i, 0) += mAccessor(Mass{}, i);
+  }
+};
+
+TEST(test_soa_dual_view, test_fields) {
+  Particles particles("particles", 10);
+
+  static_assert(std::is_same_v<
+                std::remove_reference_t<decltype(particles.get<Mass>())>,
+                Kokkos::DualView<double *>>);
+  EXPECT_EQ(particles.extent(0), 10u);
+  EXPECT_EQ(particles.get<Position>().extent(1), 3u);
+  EXPECT_EQ(particles.get<Charge>().view_host().label(), "particles[2]");
+
+  // copies share the data
+  auto copy = particles;
+  EXPECT_EQ(copy.get<Mass>().view_host().data(),
+            particles.get<Mass>().view_host().data());
+}
+
+TEST(test_soa_dual_view, test_accessor) {
+  using DeviceSpace = Kokkos::DefaultExecutionSpace::memory_space;
+  Particles particles("particles", 10);
+
+  auto accessor = dynk::getAccessor<DeviceSpace, Mass, Charge>(particles);
+  EXPECT_EQ(accessor.get<Mass>().data(),
+            particles.get<Mass>().view_device().data());
+  EXPECT_EQ(accessor.get<Charge>().data(),
+            particles.get<Charge>().view_device().data());
+}
+
+void test_soa_dual_view_per_field_sync(bool const isExecutedOnDevice) {
+  Particles particles("particles", 10);
+  for (int i = 0; i < 10; i++) {
+    particles.get<Mass>().h_view(i) = i;
+  }
+  particles.get<Position>().modify_host();
+  particles.get<Mass>().modify_host();
+  particles.get<Charge>().modify_host();
+  auto &chargeDV = particles.get<Charge>();
+  bool const isChargeSyncNeeded = isExecutedOnDevice
+                                      ? chargeDV.need_sync_device()
+                                      : chargeDV.need_sync_host();
+
+  auto accessor =
+      dynk::getSyncedAccessor<Position, Mass>(particles, isExecutedOnDevice);
+  dynk::parallel_for(isExecutedOnDevice, "move", 10, MoveFunctor(accessor));
+  dynk::setFieldsModified<Position>(particles, isExecutedOnDevice);
+
+  // the undeclared field is not synchronized
+  EXPECT_EQ(isExecutedOnDevice ? chargeDV.need_sync_device()
+                               : chargeDV.need_sync_host(),
+            isChargeSyncNeeded);
+
+  auto &positionDV = particles.get<Position>();
+  positionDV.sync_host();
+  EXPECT_EQ(positionDV.h_view(5, 0), 5.);
+  EXPECT_EQ(positionDV.h_view(5, 1), 0.);
+}
+
+TEST(test_soa_dual_view, test_per_field_sync) {
+  test_soa_dual_view_per_field_sync(true);
+  test_soa_dual_view_per_field_sync(false);
+}
+
+void test_soa_dual_view_kernel_factory(bool const isExecutedOnDevice) {
+  Particles particles("particles", 10);
+  for (int i = 0; i < 10; i++) {
+    particles.get<Mass>().h_view(i) = i;
+  }
+  particles.get<Mass>().modify_host();
+
+  dynk::parallel_for(
+      isExecutedOnDevice, "move", dynk::RangePolicy(0, 10),
+      dynk::KernelFactory([&](auto memorySpace) {
+        using MemorySpace = decltype(memorySpace);
+        auto accessor =
+            dynk::getSyncedAccessor<MemorySpace, Position, Mass>(particles);
+        dynk::setFieldsModified<MemorySpace, Position>(particles);
+        return MoveFunctor(accessor);
+      }));
+
+  auto &positionDV = particles.get<Position>();
+  positionDV.sync_host();
+  EXPECT_EQ(positionDV.h_view(7, 0), 7.);
+}
+
+TEST(test_soa_dual_view, test_kernel_factory) {
+  test_soa_dual_view_kernel_factory(true);
+  test_soa_dual_view_kernel_factory(false);
+}
@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/mapped_file.hpp"
+#include "dynk/streaming.hpp"
+
+using HostView = Kokkos::View<double *, Kokkos::HostSpace>;
+
+TEST(test_stream_policy, test_chunk_size) {
+  EXPECT_EQ(dynk::StreamPolicy().setChunkSize(64).getChunkSize(1000, 16), 64u);
+  EXPECT_EQ(dynk::StreamPolicy().setChunkSize(64).getChunkSize(10, 16), 10u);
+
+  // two buffers of 16 bytes per element
+  EXPECT_EQ(dynk::StreamPolicy().setMemoryBudget(3200).getChunkSize(1000, 16),
+            100u);
+  EXPECT_EQ(dynk::StreamPolicy().setMemoryBudget(1).getChunkSize(1000, 16),
+            1u);
+}
+
+void test_parallel_for_stream_chunks(bool const isExecutedOnDevice) {
+  // not a multiple of the chunk size, to have a partial last chunk
+  std::size_t const size = 1000;
+  HostView inputV("input", size);
+  HostView outputV("output", size);
+  for (std::size_t i = 0; i < size; i++) {
+    inputV(i) = i;
+  }
+
+  dynk::parallel_for_stream(
+      isExecutedOnDevice, "stream", inputV, outputV,
+      KOKKOS_LAMBDA(std::size_t const i, double const &in, double &out) {
+        out = 2. * in + i;
+      },
+      dynk::StreamPolicy().setChunkSize(64));
+
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_EQ(outputV(i), 3. * i);
+  }
+}
+
+TEST(test_parallel_for_stream, test_chunks) {
+  test_parallel_for_stream_chunks(true);
+  test_parallel_for_stream_chunks(false);
+}
+
+struct IncrementFunctor {
+  KOKKOS_FUNCTION void operator()(std::size_t const, double const &in,
+                                  double &out) const {
+    out = in + 1.;
+  }
+};
+
+TEST(test_parallel_for_stream, test_host_buffers) {
+  // stream from host memory to buffers in pinned host memory, which is a
+  // distinct memory space on builds with a device backend
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+  using BufferMemorySpace = Kokkos::SharedHostPinnedSpace;
+#else
+  using BufferMemorySpace = Kokkos::HostSpace;
+#endif // ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+  std::size_t const size = 100;
+  HostView dataV("data", size);
+  for (std::size_t i = 0; i < size; i++) {
+    dataV(i) = i;
+  }
+
+  // in place
+  dynk::parallel_for_stream<HostView, HostView, IncrementFunctor,
+                            Kokkos::DefaultHostExecutionSpace,
+                            BufferMemorySpace>(
+      true, "stream host buffers", dataV, dataV, IncrementFunctor(),
+      dynk::StreamPolicy().setChunkSize(7));
+
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_EQ(dataV(i), i + 1.);
+  }
+}
+
+void test_parallel_for_stream_mapped_file(bool const isExecutedOnDevice) {
+  std::string const inputPath = testing::TempDir() + "dynk_stream_input.bin";
+  std::string const outputPath =
+      testing::TempDir() + "dynk_stream_output.bin";
+  std::size_t const size = 500;
+
+  {
+    dynk::MappedFile<double> const file(inputPath, size);
+    auto const fileV = file.getView();
+    for (std::size_t i = 0; i < size; i++) {
+      fileV(i) = i;
+    }
+  }
+
+  {
+    dynk::MappedFile<double> const inputFile(inputPath);
+    dynk::MappedFile<double> const outputFile(outputPath, size);
+    EXPECT_EQ(inputFile.getCount(), size);
+
+    dynk::parallel_for_stream(
+        isExecutedOnDevice, "stream mapped file", inputFile.getView(),
+        outputFile.getView(), IncrementFunctor(),
+        dynk::StreamPolicy().setChunkSize(128));
+  }
+
+  dynk::MappedFile<double> const outputFile(outputPath);
+  auto const outputV = outputFile.getView();
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_EQ(outputV(i), i + 1.);
+  }
+
+  std::remove(inputPath.c_str());
+  std::remove(outputPath.c_str());
+}
+
+TEST(test_parallel_for_stream, test_mapped_file) {
+  test_parallel_for_stream_mapped_file(true);
+  test_parallel_for_stream_mapped_file(false);
+}
+
+TEST(test_mapped_file, test_missing) {
+  EXPECT_THROW(dynk::MappedFile<double>(testing::TempDir() +
+                                        "dynk_missing_file.bin"),
+               std::runtime_error);
+}
@@ -0,0 +1,145 @@
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/layer.hpp"
+#include "dynk/sync_diagnostics.hpp"
+#include "dynk/wrapper.hpp"
+
+namespace {
+
+int const key = 0;
+
+} // namespace
+
+TEST(test_sync_diagnostics, test_transfers) {
+  dynk::resetSyncDiagnostics();
+  auto &diagnostics = dynk::impl::SyncDiagnostics::get();
+
+  diagnostics.onSync(&key, "data", true, true, 40);
+  diagnostics.onDispatch(true);
+  diagnostics.onSync(&key, "data", true, false, 40);
+
+  auto const report = dynk::getSyncReports()["data"];
+  EXPECT_EQ(report.transfersToDevice, 1u);
+  EXPECT_EQ(report.transfersToHost, 0u);
+  EXPECT_EQ(report.bytesTransferred, 40u);
+}
+
+TEST(test_sync_diagnostics, test_ping_pong) {
+  dynk::resetSyncDiagnostics();
+  auto &diagnostics = dynk::impl::SyncDiagnostics::get();
+
+  diagnostics.onSync(&key, "data", true, true, 40);
+  diagnostics.onDispatch(true);
+  diagnostics.onModify(&key, "data", true);
+  diagnostics.onSync(&key, "data", false, true, 40);
+  diagnostics.onDispatch(false);
+  diagnostics.onModify(&key, "data", false);
+
+  // transfers separated by many kernels are not a ping-pong
+  for (int i = 0; i < 3; i++) {
+    diagnostics.onDispatch(false);
+  }
+  diagnostics.onSync(&key, "data", true, true, 40);
+
+  EXPECT_EQ(dynk::getSyncReports()["data"].pingPongs, 1u);
+}
+
+TEST(test_sync_diagnostics, test_unread_sync) {
+  dynk::resetSyncDiagnostics();
+  auto &diagnostics = dynk::impl::SyncDiagnostics::get();
+
+  diagnostics.onSync(&key, "data", true, true, 40);
+  diagnostics.onModify(&key, "data", false);
+
+  EXPECT_EQ(dynk::getSyncReports()["data"].unreadSyncs, 1u);
+
+  // a transfer still pending at the end is unread as well
+  diagnostics.onSync(&key, "data", true, true, 40);
+
+  EXPECT_EQ(dynk::getSyncReports()["data"].unreadSyncs, 2u);
+}
+
+TEST(test_sync_diagnostics, test_missing_modify) {
+  dynk::resetSyncDiagnostics();
+  auto &diagnostics = dynk::impl::SyncDiagnostics::get();
+
+  diagnostics.onSync(&key, "data", true, false, 40);
+  diagnostics.onDispatch(true);
+  diagnostics.onSync(&key, "data", false, false, 40);
+
+  // correct use
+  diagnostics.onDispatch(false);
+  diagnostics.onModify(&key, "data", false);
+  diagnostics.onSync(&key, "data", true, true, 40);
+
+  EXPECT_EQ(dynk::getSyncReports()["data"].missingModifies, 1u);
+}
+
+TEST(test_sync_diagnostics, test_failed_launch) {
+  dynk::resetSyncDiagnostics();
+  auto &diagnostics = dynk::impl::SyncDiagnostics::get();
+
+  diagnostics.onSync(&key, "data", true, true, 40);
+  EXPECT_THROW(dynk::wrap(
+                   true, [] { throw std::runtime_error("launch failure"); },
+                   [] {}),
+               std::runtime_error);
+
+  // the launch that threw is not a kernel reading the transfer
+  EXPECT_EQ(dynk::getSyncReports()["data"].unreadSyncs, 1u);
+}
+
+void test_helpers(bool const isExecutedOnDevice) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+
+  dynk::resetSyncDiagnostics();
+
+  // pre-alter data
+  dataDV.template modify<typename DualView::host_mirror_space>();
+
+  auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label", dynk::RangePolicy(0, 10),
+      KOKKOS_LAMBDA(int const i) { dataV(i) += i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  bool const isTransferExpected =
+      isExecutedOnDevice &&
+      !std::is_same_v<typename DualView::t_dev::memory_space,
+                      typename DualView::t_host::memory_space>;
+
+  auto const report = dynk::getSyncReports()["data"];
+  EXPECT_EQ(report.transfersToDevice, isTransferExpected ? 1u : 0u);
+  EXPECT_EQ(report.transfersToHost, 0u);
+  EXPECT_EQ(report.unreadSyncs, 0u);
+  EXPECT_EQ(report.missingModifies, 0u);
+}
+
+TEST(test_sync_diagnostics, test_helpers) {
+  test_helpers(true);
+  test_helpers(false);
+}
+
+TEST(test_sync_diagnostics, test_subview) {
+  using DualView = Kokkos::DualView<int *>;
+  DualView dataDV("data", 10);
+  auto const subDV = Kokkos::subview(dataDV, std::make_pair(2, 8));
+
+  dynk::resetSyncDiagnostics();
+
+  // written on device through the DualView, then requested on host through
+  // a subview without any modification marker in between
+  dynk::impl::recordSync(dataDV, true, false);
+  dynk::impl::recordDispatch(true);
+  dynk::impl::recordSync(subDV, false, false);
+
+  // the subview shares the history of its DualView
+  EXPECT_EQ(dynk::getSyncReports()["data"].missingModifies, 1u);
+}
@@ -0,0 +1,192 @@
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/task_graph.hpp"
+
+using DualView = Kokkos::DualView<int *>;
+
+template <typename View> struct FillFunctor {
+  View mDataV;
+  int mValue;
+
+  FillFunctor(View const dataV, int const value)
+      : mDataV(dataV), mValue(value) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const { mDataV(i) = mValue + i; }
+};
+
+template <typename InputView, typename OutputView> struct AddFunctor {
+  InputView mInputV;
+  OutputView mOutputV;
+
+  AddFunctor(InputView const inputV, OutputView const outputV)
+      : mInputV(inputV), mOutputV(outputV) {}
+
+  KOKKOS_FUNCTION void operator()(int const i) const {
+    mOutputV(i) += mInputV(i);
+  }
+};
+
+/**
+ * Create a kernel factory filling a DualView.
+ */
+auto fill(DualView &dataDV, int const value) {
+  return dynk::KernelFactory([&dataDV, value](auto memorySpace) {
+    return FillFunctor(dynk::getView<decltype(memorySpace)>(dataDV), value);
+  });
+}
+
+/**
+ * Create a kernel factory adding a DualView to another.
+ */
+auto add(DualView &inputDV, DualView &outputDV) {
+  return dynk::KernelFactory([&inputDV, &outputDV](auto memorySpace) {
+    using MemorySpace = decltype(memorySpace);
+    return AddFunctor(dynk::getView<MemorySpace>(inputDV),
+                      dynk::getView<MemorySpace>(outputDV));
+  });
+}
+
+TEST(test_task_graph, test_dependencies) {
+  DualView xDV("x", 10);
+  DualView yDV("y", 10);
+  DualView zDV("z", 10);
+
+  dynk::TaskGraph graph;
+  auto const fillX = graph.addTask("fill x", 10, fill(xDV, 1),
+                                   dynk::writes(xDV));
+  auto const fillY = graph.addTask("fill y", 10, fill(yDV, 2),
+                                   dynk::writes(yDV));
+  auto const addXY = graph.addTask("add x y", 10, add(xDV, yDV),
+                                   dynk::reads(xDV), dynk::readsWrites(yDV));
+  auto const addXZ = graph.addTask("add x z", 10, add(xDV, zDV),
+                                   dynk::reads(xDV), dynk::readsWrites(zDV));
+  auto const refillX = graph.addTask("refill x", 10, fill(xDV, 3),
+                                     dynk::writes(xDV));
+
+  EXPECT_EQ(graph.getSize(), 5u);
+  EXPECT_TRUE(graph.getPredecessors(fillX).empty());
+  EXPECT_TRUE(graph.getPredecessors(fillY).empty());
+  // read after write
+  EXPECT_EQ(graph.getPredecessors(addXY),
+            (std::vector<std::size_t>{fillX, fillY}));
+  EXPECT_EQ(graph.getPredecessors(addXZ), (std::vector<std::size_t>{fillX}));
+  // write after write and write after read
+  EXPECT_EQ(graph.getPredecessors(refillX),
+            (std::vector<std::size_t>{fillX, addXY, addXZ}));
+}
+
+TEST(test_task_graph, test_subview_dependencies) {
+  DualView dataDV("data", 20);
+  auto firstDV = Kokkos::subview(dataDV, std::make_pair(0, 10));
+  auto secondDV = Kokkos::subview(dataDV, std::make_pair(10, 20));
+
+  // subviews of the same allocation are dependent, even without overlap
+  dynk::TaskGraph graph;
+  auto const kernel = KOKKOS_LAMBDA(int const) {};
+  auto const writeFirst =
+      graph.addTask("write first", 10, kernel, dynk::readsWrites(firstDV));
+  auto const readSecond =
+      graph.addTask("read second", 10, kernel, dynk::reads(secondDV));
+  auto const writeAll =
+      graph.addTask("write all", 20, kernel, dynk::writes(dataDV));
+
+  EXPECT_TRUE(graph.getPredecessors(writeFirst).empty());
+  EXPECT_EQ(graph.getPredecessors(readSecond),
+            (std::vector<std::size_t>{writeFirst}));
+  EXPECT_EQ(graph.getPredecessors(writeAll),
+            (std::vector<std::size_t>{writeFirst, readSecond}));
+}
+
+TEST(test_task_graph, test_placement) {
+  DualView xDV("x", 10);
+  DualView yDV("y", 10);
+
+  dynk::TaskGraph graph;
+  auto const fillX = graph.addTask("fill x", 10, fill(xDV, 1),
+                                   dynk::writes(xDV));
+  auto const fillY = graph.addTask("fill y", 10, fill(yDV, 2),
+                                   dynk::writes(yDV));
+  auto const addXY = graph.addTask("add x y", 10, add(xDV, yDV),
+                                   dynk::reads(xDV), dynk::readsWrites(yDV));
+
+  // each task is cheaper on one side
+  graph.setCost(fillX, 1., 2.).setCost(fillY, 2., 1.).setCost(addXY, 1., 3.);
+  graph.plan();
+  EXPECT_TRUE(graph.isExecutedOnDevice(fillX));
+  EXPECT_FALSE(graph.isExecutedOnDevice(fillY));
+  EXPECT_TRUE(graph.isExecutedOnDevice(addXY));
+  EXPECT_GE(graph.getMakespan(), 2.);
+
+  // forced side
+  graph.setSide(addXY, false);
+  graph.plan();
+  EXPECT_FALSE(graph.isExecutedOnDevice(addXY));
+}
+
+TEST(test_task_graph, test_transfer_aware_placement) {
+  if (dynk::impl::isSingleAllocation<DualView>()) {
+    GTEST_SKIP() << "DualView is not transferred";
+  }
+
+  DualView xDV("x", 1000);
+  DualView yDV("y", 1000);
+
+  dynk::TaskGraph graph;
+  graph.setBandwidth(1000.);
+  auto const fillX = graph.addTask("fill x", 1000, fill(xDV, 1),
+                                   dynk::writes(xDV));
+  auto const addXY = graph.addTask("add x y", 1000, add(xDV, yDV),
+                                   dynk::reads(xDV), dynk::readsWrites(yDV));
+
+  // cheaper on device, but the data is produced on host and would have to be
+  // transferred
+  graph.setSide(fillX, false).setCost(addXY, 1., 2.);
+  graph.plan();
+  EXPECT_FALSE(graph.isExecutedOnDevice(addXY));
+}
+
+void test_task_graph_run(bool const isFilledOnDevice) {
+  DualView xDV("x", 10);
+  DualView yDV("y", 10);
+  DualView zDV("z", 10);
+
+  dynk::TaskGraph graph;
+  auto const fillX = graph.addTask("fill x", 10, fill(xDV, 1),
+                                   dynk::writes(xDV));
+  auto const fillY = graph.addTask("fill y", 10, fill(yDV, 2),
+                                   dynk::writes(yDV));
+  auto const addXY = graph.addTask("add x y", 10, add(xDV, yDV),
+                                   dynk::reads(xDV), dynk::readsWrites(yDV));
+  auto const fillZ = graph.addTask("fill z", dynk::RangePolicy(0, 10),
+                                   fill(zDV, 0), dynk::writes(zDV));
+  graph.addTask("add y z", 10, add(yDV, zDV), dynk::reads(yDV),
+                dynk::readsWrites(zDV));
+
+  // alternate sides on the dependencies
+  graph.setSide(fillX, isFilledOnDevice)
+      .setSide(fillY, !isFilledOnDevice)
+      .setSide(addXY, isFilledOnDevice)
+      .setSide(fillZ, !isFilledOnDevice);
+
+  // execute twice, as for two steps of a simulation
+  for (int step = 0; step < 2; step++) {
+    graph.run();
+
+    auto const hostV = dynk::getSyncedView(zDV, false);
+    for (int i = 0; i < 10; i++) {
+      EXPECT_EQ(hostV(i), 3 + 3 * i);
+    }
+  }
+}
+
+TEST(test_task_graph, test_run) {
+  test_task_graph_run(true);
+  test_task_graph_run(false);
+}
@@ -0,0 +1,174 @@
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/layer.hpp"
+#include "dynk/scatter_view.hpp"
+
+using DualView = Kokkos::DualView<int *>;
+
+int const threadsCount = 8;
+int const iterationsCount = 100;
+
+/**
+ * Execute a function concurrently in several threads and join them.
+ *
+ * Threads release their execution space instances before exiting.
+ */
+void runThreads(std::function<void(int)> const &function) {
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < threadsCount; thread++) {
+    threads.emplace_back([&function, thread] {
+      function(thread);
+      dynk::releaseThreadSpaces();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * Work of a thread, driving its own DualView and alternating sides.
+ */
+int stress(DualView &dataDV, int const thread) {
+  for (int iteration = 0; iteration < iterationsCount; iteration++) {
+    bool const isExecutedOnDevice = (iteration + thread) % 2 == 0;
+    auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+    dynk::parallel_for(
+        isExecutedOnDevice, "stress", 1000,
+        KOKKOS_LAMBDA(int const i) { dataV(i) += 1; });
+    dynk::setModified(dataDV, isExecutedOnDevice);
+  }
+
+  auto const dataV = dynk::getSyncedView(dataDV, true);
+  int sum = 0;
+  dynk::parallel_reduce(
+      true, "stress sum", 1000,
+      KOKKOS_LAMBDA(int const i, int &partialSum) { partialSum += dataV(i); },
+      sum);
+  return sum;
+}
+
+TEST(test_thread_safety, test_stress) {
+  std::vector<DualView> dataDVs;
+  for (int thread = 0; thread < threadsCount; thread++) {
+    dataDVs.emplace_back("data", 1000);
+  }
+  std::vector<int> sums(threadsCount, 0);
+
+  runThreads([&](int const thread) {
+    sums[thread] = stress(dataDVs[thread], thread);
+  });
+
+  for (int thread = 0; thread < threadsCount; thread++) {
+    EXPECT_EQ(sums[thread], 1000 * iterationsCount);
+    dataDVs[thread].template sync<typename DualView::host_mirror_space>();
+    EXPECT_EQ(dataDVs[thread].h_view(999), iterationsCount);
+  }
+}
+
+TEST(test_thread_safety, test_release) {
+  using Spaces = dynk::impl::ThreadSpaces<Kokkos::DefaultExecutionSpace>;
+
+  runThreads([](int const) {
+    Spaces::get().getSpace();
+    EXPECT_GE(Spaces::get().getSize(), 1u);
+  });
+
+  EXPECT_EQ(Spaces::get().getSize(), 0u);
+}
+
+/**
+ * Work of a thread sharing a DualView with the others, incrementing its own
+ * indices.
+ */
+void increment(DualView &dataDV, int const thread) {
+  int const begin = thread * 10;
+  for (int iteration = 0; iteration < iterationsCount; iteration++) {
+    auto dataV = dynk::getSyncedView(dataDV, true);
+    dynk::parallel_for(
+        true, "increment", dynk::RangePolicy(begin, begin + 10),
+        KOKKOS_LAMBDA(int const i) { dataV(i) += 1; });
+    dynk::setModified(dataDV, true);
+  }
+}
+
+TEST(test_thread_safety, test_shared_state) {
+  DualView dataDV("data", threadsCount * 10);
+
+  // concurrent state transitions of the same DualView, on disjoint indices
+  runThreads([&](int const thread) { increment(dataDV, thread); });
+
+  // no increment was lost, e.g. by a spurious copy between sides
+  dynk::getSyncedView(dataDV, false);
+  for (int i = 0; i < threadsCount * 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), iterationsCount);
+  }
+}
+
+/**
+ * Work of a thread sharing a DualView with the others, incrementing its own
+ * indices alternatively through the DualView and through a subview of it.
+ */
+void incrementSubview(DualView &dataDV, int const thread) {
+  int const begin = thread * 10;
+  // the subview has another type than the DualView, but shares its state
+  auto subDV = Kokkos::subview(dataDV, std::make_pair(begin, begin + 10));
+  for (int iteration = 0; iteration < iterationsCount; iteration++) {
+    if (iteration % 2 == 0) {
+      auto dataV = dynk::getSyncedView(dataDV, true);
+      dynk::parallel_for(
+          true, "increment", dynk::RangePolicy(begin, begin + 10),
+          KOKKOS_LAMBDA(int const i) { dataV(i) += 1; });
+      dynk::setModified(dataDV, true);
+    } else {
+      auto subV = dynk::getSyncedView(subDV, true);
+      dynk::parallel_for(
+          true, "increment subview", 10,
+          KOKKOS_LAMBDA(int const i) { subV(i) += 1; });
+      dynk::setModified(subDV, true);
+    }
+  }
+}
+
+TEST(test_thread_safety, test_shared_subview_state) {
+  DualView dataDV("data", threadsCount * 10);
+
+  // concurrent state transitions of the same allocation, through DualViews
+  // of different types
+  runThreads([&](int const thread) { incrementSubview(dataDV, thread); });
+
+  dynk::getSyncedView(dataDV, false);
+  for (int i = 0; i < threadsCount * 10; i++) {
+    EXPECT_EQ(dataDV.h_view(i), iterationsCount);
+  }
+}
+
+TEST(test_thread_safety, test_scatter) {
+  std::vector<DualView> binsDVs;
+  for (int thread = 0; thread < threadsCount; thread++) {
+    binsDVs.emplace_back("bins", 10);
+  }
+
+  // other dynamic constructs launch on the instances of each thread as well
+  runThreads([&](int const thread) {
+    for (int iteration = 0; iteration < iterationsCount; iteration++) {
+      dynk::parallel_scatter(
+          (iteration + thread) % 2 == 0, "scatter", dynk::RangePolicy(0, 100),
+          binsDVs[thread],
+          KOKKOS_LAMBDA(int const i, auto &access) { access(i % 10) += 1; });
+    }
+  });
+
+  for (int thread = 0; thread < threadsCount; thread++) {
+    dynk::getSyncedView(binsDVs[thread], false);
+    EXPECT_EQ(binsDVs[thread].h_view(0), 10 * iterationsCount);
+  }
+}
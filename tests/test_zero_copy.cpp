@@ -0,0 +1,85 @@
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DualView.hpp>
+#include <gtest/gtest.h>
+
+#include "dynk/dual_view.hpp"
+#include "dynk/layer.hpp"
+
+// SharedDualView requires Kokkos::SharedSpace
+#ifdef KOKKOS_HAS_SHARED_SPACE
+
+using SharedDualView = dynk::SharedDualView<int *>;
+
+TEST(test_zero_copy, test_dual_view_type) {
+#ifdef DYNK_ENABLE_ZERO_COPY
+  static_assert(std::is_same_v<dynk::DualView<int *>, SharedDualView>);
+#else
+  static_assert(std::is_same_v<dynk::DualView<int *>, Kokkos::DualView<int *>>);
+#endif // ifdef DYNK_ENABLE_ZERO_COPY
+  static_assert(dynk::impl::isSingleAllocation<SharedDualView>());
+}
+
+TEST(test_zero_copy, test_single_allocation) {
+  SharedDualView dataDV("data", 10);
+
+  auto deviceV = dynk::getSyncedView(dataDV, true);
+  auto hostV = dynk::getSyncedView(dataDV, false);
+  EXPECT_EQ(deviceV.data(), hostV.data());
+}
+
+TEST(test_zero_copy, test_sync_state) {
+  if (!dynk::impl::isDeviceSide<Kokkos::DefaultExecutionSpace::memory_space,
+                                SharedDualView>()) {
+    GTEST_SKIP() << "Device and host sides are the same";
+  }
+
+  SharedDualView dataDV("data", 10);
+
+  // synchronizing only clears the modification marker
+  dynk::setModified(dataDV, true);
+  EXPECT_TRUE(dataDV.need_sync_host());
+  dynk::getSyncedView(dataDV, false);
+  EXPECT_FALSE(dataDV.need_sync_host());
+
+  dynk::setModified(dataDV, false);
+  EXPECT_TRUE(dataDV.need_sync_device());
+  dynk::getSyncedView(dataDV, true);
+  EXPECT_FALSE(dataDV.need_sync_device());
+}
+
+void test_zero_copy_parallel_for(bool const isExecutedOnDevice,
+                                 bool const isPrefetched) {
+  dynk::enableSharedPrefetch(isPrefetched);
+  SharedDualView dataDV("data", 10);
+
+  // alternate sides, data is never transferred
+  auto dataV = dynk::getSyncedView(dataDV, isExecutedOnDevice);
+  dynk::parallel_for(
+      isExecutedOnDevice, "label", 10,
+      KOKKOS_LAMBDA(int const i) { dataV(i) = i; });
+  dynk::setModified(dataDV, isExecutedOnDevice);
+
+  auto otherV = dynk::getSyncedView(dataDV, !isExecutedOnDevice);
+  dynk::parallel_for(
+      !isExecutedOnDevice, "label", 10,
+      KOKKOS_LAMBDA(int const i) { otherV(i) += i; });
+  dynk::setModified(dataDV, !isExecutedOnDevice);
+
+  auto const hostV = dynk::getSyncedView(dataDV, false);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(hostV(i), 2 * i);
+  }
+
+  dynk::enableSharedPrefetch(false);
+}
+
+TEST(test_zero_copy, test_parallel_for) {
+  test_zero_copy_parallel_for(true, false);
+  test_zero_copy_parallel_for(false, false);
+  test_zero_copy_parallel_for(true, true);
+  test_zero_copy_parallel_for(false, true);
+}
+
+#endif // ifdef KOKKOS_HAS_SHARED_SPACE
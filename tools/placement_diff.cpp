@@ -0,0 +1,54 @@
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+
+#include "dynk/placement_log.hpp"
+
+/**
+ * Compare two placement logs recorded with `dynk::startPlacementRecording`,
+ * and report per label the number of calls, the number of calls on device,
+ * the number of calls placed differently, and the total durations with their
+ * difference.
+ */
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <first log> <second log>\n";
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto const differences = dynk::diffPlacementLogs(
+        dynk::readPlacementLog(argv[1]), dynk::readPlacementLog(argv[2]));
+
+    std::cout << std::left << std::setw(32) << "label" << std::right
+              << std::setw(14) << "calls" << std::setw(14) << "on device"
+              << std::setw(10) << "changes" << std::setw(14) << "first (s)"
+              << std::setw(14) << "second (s)" << std::setw(14) << "diff (s)"
+              << "\n";
+
+    std::cout << std::fixed << std::setprecision(6);
+    double totalTime[2] = {0., 0.};
+    for (auto const &[label, difference] : differences) {
+      std::cout << std::left << std::setw(32) << label << std::right
+                << std::setw(7) << difference.callsCount[0] << std::setw(7)
+                << difference.callsCount[1] << std::setw(7)
+                << difference.deviceCallsCount[0] << std::setw(7)
+                << difference.deviceCallsCount[1] << std::setw(10)
+                << difference.sideChangesCount << std::setw(14)
+                << difference.time[0] << std::setw(14) << difference.time[1]
+                << std::setw(14) << difference.time[1] - difference.time[0]
+                << "\n";
+      totalTime[0] += difference.time[0];
+      totalTime[1] += difference.time[1];
+    }
+
+    std::cout << std::left << std::setw(70) << "total" << std::right
+              << std::setw(14) << totalTime[0] << std::setw(14) << totalTime[1]
+              << std::setw(14) << totalTime[1] - totalTime[0] << "\n";
+  } catch (std::exception const &error) {
+    std::cerr << error.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}